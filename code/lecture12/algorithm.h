@@ -43,6 +43,35 @@ void reverse_iota(I first, I last) {
   std::reverse(first, last);
 }
 
+template <BidirectionalIterator I>
+void hill(I first, I last) {
+  I middle = first;
+  std::advance(middle, std::distance(first, last) / 2);
+  iota(first, middle);
+  reverse_iota(middle, last);
+}
+
+template <BidirectionalIterator I>
+void valley(I first, I last) {
+  I middle = first;
+  std::advance(middle, std::distance(first, last) / 2);
+  reverse_iota(first, middle);
+  iota(middle, last);
+}
+
+template <ForwardIterator I>
+void sawtooth(I first, I last) {
+  // teeth of 16: ascending runs that a predictor learns, but the
+  // smallest values come back every 16 elements
+  typedef typename std::iterator_traits<I>::value_type T;
+  T value(0);
+  while (first != last) {
+    *first = value;
+    value = value == T(15) ? T(0) : T(value + 1);
+    ++first;
+  }
+}
+
 template <typename I>
 void print_range(I first, I last) {
   while (first != last) {
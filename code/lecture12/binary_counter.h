@@ -1,7 +1,26 @@
 #ifndef BINARY_COUNTER_H
 #define BINARY_COUNTER_H
 
+#include <cstddef>
 #include <vector>
+#include <array>
+#include <stdint.h>
+
+template <typename T, typename Op>
+// requires Op is BinaryOperation(T) and Op is associative
+// reduces the n = 2^k values in [first, first + n) pairwise, in place,
+// into the same balanced tree a binary counter builds from them
+T reduce_balanced_block(T* first, std::size_t n, Op& op) {
+  while (n > 1) {
+    n >>= 1;
+    for (std::size_t i = 0; i < n; ++i) first[i] = op(first[2 * i], first[2 * i + 1]);
+  }
+  return first[0];
+}
+
+// add_range reduces blocks of 2^counter_block_level values before they
+// reach the counter
+const int counter_block_level = 4;
 
 template <typename Op, typename T = typename Op::argument_type>
 class binary_counter
@@ -22,6 +41,41 @@ public:
     if (x != zero) counter.push_back(x);
   }
 
+  bool empty_below(std::size_t k) const {
+    for (std::size_t i = 0; i < k && i < counter.size(); ++i) {
+      if (counter[i] != zero) return false;
+    }
+    return true;
+  }
+
+  // adds x, the value of 2^k elements, starting the carry at slot k
+  void add_at_level(T x, std::size_t k) {
+    // precondition: empty_below(k)
+    if (counter.size() < k) counter.resize(k, zero);
+    x = add_to_counter(counter.begin() + k, counter.end(), op, zero, x);
+    if (x != zero) counter.push_back(x);
+  }
+
+  template <typename I>
+  // requires I is InputIterator and ValueType(I) == T
+  void add_range(I first, I last) {
+    const std::size_t block_size = std::size_t(1) << counter_block_level;
+    T block[block_size];
+    while (first != last) {
+      if (!empty_below(counter_block_level)) {
+        add(*first++);
+        continue;
+      }
+      std::size_t n = 0;
+      while (n < block_size && first != last) block[n++] = *first++;
+      if (n == block_size) {
+        add_at_level(reduce_balanced_block(block, n, op), counter_block_level);
+      } else {
+        for (std::size_t i = 0; i < n; ++i) add(block[i]);
+      }
+    }
+  }
+
   // returns: value of the counter
   T reduce() {
     return reduce_counter(counter.begin(), counter.end(), op, zero);
@@ -64,4 +118,175 @@ T reduce_counter(I first, I last, Op op, const T& zero) {
     }
     return result;
 }
+inline
+int count_trailing_zeros(uint64_t x) {
+  // precondition: x != 0
+#if defined(__GNUC__)
+  return __builtin_ctzll(x);
+#else
+  int n = 0;
+  while (!(x & 1)) {
+    x >>= 1;
+    ++n;
+  }
+  return n;
+#endif
+}
+
+// binary_counter with all 64 slots inline and a bitmask of the occupied
+// ones: no allocation, and no comparisons with zero. Adding x carries
+// through the run of occupied slots at the bottom of the mask, and the
+// new mask is just the old one plus 1.
+
+template <typename Op, typename T = typename Op::argument_type>
+class fixed_binary_counter
+{
+private:
+  std::array<T, 64> counter;
+  uint64_t occupied;
+  Op op;
+  T zero;
+
+public:
+  fixed_binary_counter(const Op& op, const T& zero) :
+    occupied(0), op(op), zero(zero) {}
+
+  void add(T x) {
+    // precondition: fewer than 2^64 - 1 values have been added
+    add_at_level(x, 0);
+  }
+
+  bool empty_below(int k) const {
+    return !(occupied & ((uint64_t(1) << k) - 1));
+  }
+
+  // adds x, the value of 2^k elements, starting the carry at slot k
+  void add_at_level(T x, int k) {
+    // precondition: empty_below(k)
+    int j = k + count_trailing_zeros(~(occupied >> k));
+    for (int i = k; i < j; ++i) x = op(counter[i], x);
+    counter[j] = x;
+    occupied += uint64_t(1) << k;
+  }
+
+  template <typename I>
+  // requires I is InputIterator and ValueType(I) == T
+  void add_range(I first, I last) {
+    const std::size_t block_size = std::size_t(1) << counter_block_level;
+    T block[block_size];
+    while (first != last) {
+      if (!empty_below(counter_block_level)) {
+        add(*first++);
+        continue;
+      }
+      std::size_t n = 0;
+      while (n < block_size && first != last) block[n++] = *first++;
+      if (n == block_size) {
+        add_at_level(reduce_balanced_block(block, n, op), counter_block_level);
+      } else {
+        for (std::size_t i = 0; i < n; ++i) add(block[i]);
+      }
+    }
+  }
+
+  // removes the values in the slots below k, e.g. to make room for a
+  // value of level k that is newer than all of them
+  // returns: their reduction, or zero if there are none
+  T take_below(int k) {
+    uint64_t below = occupied & ((uint64_t(1) << k) - 1);
+    occupied -= below;
+    return reduce_slots(below);
+  }
+
+  // returns: value of the counter
+  T reduce() {
+    return reduce_slots(occupied);
+  }
+
+private:
+  T reduce_slots(uint64_t rest) {
+    if (!rest) return zero;
+    int i = count_trailing_zeros(rest);
+    T result = counter[i];
+    rest &= rest - 1;
+    while (rest) {
+      i = count_trailing_zeros(rest);
+      result = op(counter[i], result);
+      rest &= rest - 1;
+    }
+    return result;
+  }
+};
+
+// fixed_binary_counter for unbounded streams: upper[i] caches the
+// reduction of the occupied slots from the top (oldest) down to i, so
+// an add refreshes one cache entry and reduce() is a lookup. The oldest
+// batch (the top slot) can be dropped for sliding window aggregates.
+// Since slots and cache share values, Op must not consume or modify its
+// arguments (a merge of linked lists does; a min or a sum does not).
+
+template <typename Op, typename T = typename Op::argument_type>
+class streaming_binary_counter
+{
+private:
+  std::array<T, 64> counter;
+  std::array<T, 64> upper;
+  uint64_t occupied;
+  Op op;
+  T zero;
+
+  void update_upper(int i) {
+    uint64_t above = i == 63 ? 0 : occupied >> (i + 1);
+    if (above) {
+      upper[i] = op(upper[i + 1 + count_trailing_zeros(above)], counter[i]);
+    } else {
+      upper[i] = counter[i];
+    }
+  }
+
+public:
+  streaming_binary_counter(const Op& op, const T& zero) :
+    occupied(0), op(op), zero(zero) {}
+
+  // the number of values currently aggregated
+  uint64_t size() const { return occupied; }
+
+  bool empty() const { return !occupied; }
+
+  void add(T x) {
+    int k = count_trailing_zeros(~occupied);
+    for (int i = 0; i < k; ++i) x = op(counter[i], x);
+    counter[k] = x;
+    ++occupied;
+    update_upper(k);
+  }
+
+  // returns: value of the counter, without changing it
+  T reduce() const {
+    if (!occupied) return zero;
+    return upper[count_trailing_zeros(occupied)];
+  }
+
+  // the number of values in the oldest batch
+  uint64_t oldest_size() const {
+    // precondition: !empty()
+    uint64_t top = occupied;
+    while (top & (top - 1)) top &= top - 1;
+    return top;
+  }
+
+  // removes the oldest batch of oldest_size() values
+  // returns: its reduced value
+  T pop_oldest() {
+    // precondition: !empty()
+    uint64_t top = oldest_size();
+    T x = counter[count_trailing_zeros(top)];
+    occupied -= top;
+    for (int i = 63; i >= 0; --i) {
+      if ((occupied >> i) & 1) update_upper(i);
+    }
+    return x;
+  }
+};
+
 #endif
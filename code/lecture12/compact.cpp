@@ -0,0 +1,75 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <vector>
+#include "algorithm.h"
+#include "timer.h"
+#include "list_pool.h"
+
+typedef list_pool<int>::list_type list_type;
+
+// builds number_of_lists lists of random_iota values by pushing onto a
+// randomly chosen list each time, so consecutive nodes of a list are
+// scattered across the pool
+
+void fragmented_lists(list_pool<int>& pool, std::vector<list_type>& heads, size_t n) {
+  std::vector<int> values(n);
+  random_iota(values.begin(), values.end());
+  for (size_t i = 0; i < n; ++i) {
+    list_type& head = heads[std::rand() % heads.size()];
+    head = pool.allocate(values[i], head);
+  }
+  // free every other list so the pool also has holes
+  for (size_t i = 0; i < heads.size(); i += 2) {
+    list_type x = heads[i];
+    while (!pool.is_end(x)) x = pool.free(x);
+    heads[i] = pool.end();
+  }
+}
+
+double time_traversal(list_pool<int>& pool, const std::vector<list_type>& heads, size_t count) {
+  timer t;
+  t.start();
+  int sum = 0;
+  for (size_t i = 0; i < count; ++i) {
+    for (size_t j = 0; j < heads.size(); ++j) {
+      list_pool<int>::iterator first(pool, heads[j]);
+      list_pool<int>::iterator last(pool);
+      while (first != last) sum += *first++;
+    }
+  }
+  double time = t.stop();
+  if (sum == 1) std::cout << sum; // keep the traversal alive
+  return time;
+}
+
+int main() {
+  const size_t max_size(16 * 1024 * 1024);
+  std::cout << std::right << std::setw(12) << "size"
+            << std::setw(12) << "fragmented"
+            << std::setw(12) << "compacted"
+            << std::setw(12) << "size ratio" << std::endl;
+  for (size_t n(1024); n <= max_size; n *= 4) {
+    list_pool<int> pool;
+    std::vector<list_type> heads(16, pool.end());
+    fragmented_lists(pool, heads, n);
+    size_t count = max_size / n;
+    size_t nodes = 0;
+    for (size_t j = 0; j < heads.size(); ++j) {
+      list_pool<int>::iterator first(pool, heads[j]);
+      nodes += std::distance(first, list_pool<int>::iterator(pool));
+    }
+    double before = time_traversal(pool, heads, count);
+    size_t size_before = pool.size();
+    pool.compact(heads.begin(), heads.end());
+    double after = time_traversal(pool, heads, count);
+    pool.shrink();
+    std::cout << std::setw(12) << n << std::fixed << std::setprecision(2)
+              << std::setw(12) << before / double(nodes * count)
+              << std::setw(12) << after / double(nodes * count)
+              << std::setw(12) << double(pool.size()) / double(size_before)
+              << std::endl;
+  }
+}
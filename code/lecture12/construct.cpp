@@ -0,0 +1,70 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <vector>
+#include "algorithm.h"
+#include "timer.h"
+#include "list_pool.h"
+#include "list_algorithm.h"
+
+// a list built node by node with push_back takes its nodes from the free
+// list, wherever earlier frees left them; generate_list_contiguous builds
+// it at the back of the pool. ns per node to build, traverse and sort
+// each one.
+
+typedef list_pool<int, uint32_t> pool_type;
+typedef pool_type::iterator I;
+
+// a pool of n nodes, all free, in random order
+void scatter_free_list(pool_type& pool, size_t n) {
+  std::vector<pool_type::list_type> nodes(n);
+  for (size_t i = 0; i < n; ++i) nodes[i] = pool.allocate(0, pool.end());
+  std::random_shuffle(nodes.begin(), nodes.end());
+  for (size_t i = 0; i < n; ++i) pool.free(nodes[i]);
+}
+
+I push_back_list(const std::vector<int>& values, I tail) {
+  push_front(tail, values[0]);
+  I front = tail;
+  for (size_t i = 1; i < values.size(); ++i) {
+    push_back(tail, values[i]);
+    ++tail;
+  }
+  return front;
+}
+
+void time_list(const std::vector<int>& values, bool contiguous) {
+  pool_type pool;
+  scatter_free_list(pool, values.size());
+  I nil(pool);
+  timer t;
+  t.start();
+  I list = contiguous ? generate_list_contiguous(values.begin(), values.end(), nil) : push_back_list(values, nil);
+  double build = t.stop();
+  t.start();
+  int sum = 0;
+  for (I i = list; i != nil; ++i) sum += *i;
+  double traverse = t.stop();
+  t.start();
+  list = mergesort_linked(list, nil, std::less<int>());
+  double sort = t.stop();
+  double n = double(values.size());
+  std::cout << std::setw(10) << std::fixed << std::setprecision(1) << build / n
+            << std::setw(10) << traverse / n << std::setw(10) << sort / n;
+  if (sum == 1) std::cout << sum; // keep the traversal alive
+}
+
+int main() {
+  std::cout << std::setw(10) << "n" << std::setw(32) << "push_back: build, walk, sort"
+            << std::setw(34) << "contiguous: build, walk, sort" << std::endl;
+  for (size_t n = 1024; n <= 16 * 1024 * 1024; n *= 16) {
+    std::vector<int> values(n);
+    random_iota(values.begin(), values.end());
+    std::cout << std::setw(10) << n;
+    time_list(values, false);
+    time_list(values, true);
+    std::cout << std::endl;
+  }
+}
@@ -0,0 +1,109 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <vector>
+#include "timer.h"
+#include "list_pool.h"
+#include "list_algorithm.h"
+
+// mergesort_linked against sort_linked_gather_key (the int key),
+// sort_linked_gather (the whole value) and sort_linked by list length and
+// node size: ns per node. The nodes of each list are linked in random
+// order through the pool, as they are after a while of allocating and
+// freeing. This is the source of the sort_linked thresholds.
+
+enum sort_kind { merge, gather_key, gather_value, automatic };
+
+template <std::size_t bytes>
+struct record
+{
+  int key;
+  char payload[bytes - sizeof(int)];
+};
+
+// just the key: no zero-length payload
+template <>
+struct record<sizeof(int)>
+{
+  int key;
+};
+
+template <std::size_t bytes>
+struct less_key
+{
+  bool operator()(const record<bytes>& x, const record<bytes>& y) const { return x.key < y.key; }
+};
+
+template <std::size_t bytes>
+struct get_key
+{
+  int operator()(const record<bytes>& x) const { return x.key; }
+};
+
+template <std::size_t bytes>
+typename list_pool<record<bytes>, uint32_t>::iterator
+shuffled_list(list_pool<record<bytes>, uint32_t>& pool, std::size_t n) {
+  typedef typename list_pool<record<bytes>, uint32_t>::iterator I;
+  std::vector<I> nodes;
+  nodes.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    record<bytes> x;
+    x.key = std::rand();
+    nodes.push_back(I(pool, pool.allocate(x, pool.end())));
+  }
+  std::random_shuffle(nodes.begin(), nodes.end());
+  for (std::size_t i = 1; i < n; ++i) set_successor(nodes[i - 1], nodes[i]);
+  return nodes[0];
+}
+
+template <std::size_t bytes>
+double time_sort(std::size_t n, sort_kind kind) {
+  typedef list_pool<record<bytes>, uint32_t> pool_type;
+  typedef typename pool_type::iterator I;
+  // the same total number of nodes for every length
+  std::size_t repeat = std::max(std::size_t(1), (std::size_t(1) << 22) / n);
+  double time = 0;
+  bool sorted = true;
+  for (std::size_t r = 0; r < repeat; ++r) {
+    pool_type pool(n);
+    I nil(pool);
+    std::srand(unsigned(r));
+    I list = shuffled_list<bytes>(pool, n);
+    timer t;
+    t.start();
+    if (kind == merge) list = mergesort_linked(list, nil, less_key<bytes>());
+    else if (kind == gather_key) list = sort_linked_gather_key(list, nil, get_key<bytes>(), std::less<int>());
+    else if (kind == gather_value) list = sort_linked_gather(list, nil, less_key<bytes>());
+    else list = sort_linked(list, nil, less_key<bytes>());
+    time += t.stop();
+    sorted = sorted && std::is_sorted(list, nil, less_key<bytes>())
+                    && std::size_t(std::distance(list, nil)) == n;
+  }
+  if (!sorted) std::cout << " *** WRONG ***";
+  return time / double(n * repeat);
+}
+
+template <std::size_t bytes>
+void print_times() {
+  std::cout << sizeof(record<bytes>) << "-byte nodes, ns per node" << std::endl;
+  std::cout << std::setw(10) << "n" << std::setw(10) << "merge" << std::setw(10) << "key"
+            << std::setw(10) << "value" << std::setw(12) << "sort_linked" << std::endl;
+  for (std::size_t n = 16; n <= (std::size_t(1) << 22); n *= 4) {
+    std::cout << std::setw(10) << n << std::fixed << std::setprecision(1);
+    std::cout << std::setw(10) << time_sort<bytes>(n, merge);
+    std::cout << std::setw(10) << time_sort<bytes>(n, gather_key);
+    std::cout << std::setw(10) << time_sort<bytes>(n, gather_value);
+    std::cout << std::setw(12) << time_sort<bytes>(n, automatic) << std::endl;
+  }
+}
+
+int main() {
+  print_times<4>();
+  print_times<16>();
+  print_times<32>();
+  print_times<64>();
+  print_times<128>();
+  print_times<256>();
+}
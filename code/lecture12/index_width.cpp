@@ -0,0 +1,56 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <vector>
+#include <stdint.h>
+#include "algorithm.h"
+#include "timer.h"
+#include "list_pool.h"
+#include "list_algorithm.h"
+
+// time per node of mergesort_linked and bytes per node for a pool
+// of n uint32_t values indexed by N
+
+template <typename N>
+std::pair<double, double> time_mergesort_linked(const std::vector<uint32_t>& vec) {
+  typedef typename list_pool<uint32_t, N>::iterator I;
+  list_pool<uint32_t, N> pool(vec.size());
+  if (vec.size() > pool.max_size()) return std::make_pair(0.0, 0.0);
+  I nil(pool);
+  I list = generate_list(vec.begin(), vec.end(), nil);
+  timer t;
+  t.start();
+  list = mergesort_linked(list, nil, std::less<uint32_t>());
+  double time = t.stop();
+  if (!std::is_sorted(list, nil)) std::cerr << "*** SORT FAILED! ***" << std::endl;
+  return std::make_pair(time / double(vec.size()),
+                        double(pool.memory_size()) / double(vec.size()));
+}
+
+int main() {
+  const size_t max_size(16 * 1024 * 1024);
+  int colwidth = 10;
+  std::cout << std::right << std::setw(12) << "size"
+            << std::setw(colwidth) << "ns 16"
+            << std::setw(colwidth) << "ns 32"
+            << std::setw(colwidth) << "ns 64"
+            << std::setw(colwidth) << "bytes 16"
+            << std::setw(colwidth) << "bytes 32"
+            << std::setw(colwidth) << "bytes 64" << std::endl;
+  for (size_t n(1024); n <= max_size; n *= 4) {
+    std::vector<uint32_t> vec(n);
+    random_iota(vec.begin(), vec.end());
+    std::pair<double, double> r16 = time_mergesort_linked<uint16_t>(vec);
+    std::pair<double, double> r32 = time_mergesort_linked<uint32_t>(vec);
+    std::pair<double, double> r64 = time_mergesort_linked<uint64_t>(vec);
+    std::cout << std::setw(12) << n << std::fixed << std::setprecision(0)
+              << std::setw(colwidth) << r16.first
+              << std::setw(colwidth) << r32.first
+              << std::setw(colwidth) << r64.first
+              << std::setw(colwidth) << r16.second
+              << std::setw(colwidth) << r32.second
+              << std::setw(colwidth) << r64.second << std::endl;
+  }
+}
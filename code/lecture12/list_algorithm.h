@@ -1,5 +1,13 @@
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include "binary_counter.h"
+#include "parallel_binary_counter.h"
 
 #include "merge_linked.h"
 
@@ -39,20 +47,291 @@ struct mergesort_linked_operation
   I operator()(I x, I y) { return merge_linked_simple(x, nil, y, nil, cmp); }
 };
 
-template <typename I, typename Compare>
+template <typename I, typename N, typename Compare>
 // I is Linked Iterator
-I mergesort_linked(I first, I last, Compare cmp) {
+// N is Integral
+// sorts the n nodes starting at first one node at a time: every node
+// enters the counter at level 0; the reference for mergesort_linked_n
+I mergesort_linked_nodes_n(I first, N n, I last, Compare cmp) {
   mergesort_linked_operation<I, Compare> op(last, cmp);
-  binary_counter<mergesort_linked_operation<I, Compare> > counter(op, last);
-  counter.reserve(16);
-  while (first != last) {
+  fixed_binary_counter<mergesort_linked_operation<I, Compare> > counter(op, last);
+  while (n != N(0)) {
     I tmp = first++;
     set_successor(tmp, last);
     counter.add(tmp);
+    --n;
+  }
+  return counter.reduce();
+}
+
+template <typename I, typename N, typename Compare>
+// I is Linked Iterator
+// N is Integral
+// stable insertion sort of the n nodes starting at first into a list
+// terminated by last; a node not less than the current back is appended
+// without a search, so ascending input takes n - 1 comparisons
+// returns: the sorted list and the node that followed the n nodes
+std::pair<I, I> insertion_sort_linked_n(I first, N n, I last, Compare cmp) {
+  if (n == N(0)) return std::make_pair(last, first);
+  I head = first++;
+  I back = head;
+  set_successor(back, last);
+  while (--n != N(0)) {
+    I x = first++;
+    if (!cmp(*x, *back)) {
+      set_successor(back, x);
+      set_successor(x, last);
+      back = x;
+    } else if (cmp(*x, *head)) {
+      set_successor(x, head);
+      head = x;
+    } else {
+      I previous = head;
+      I current = head;
+      ++current;
+      while (!cmp(*x, *current)) previous = current++;
+      set_successor(previous, x);
+      set_successor(x, current);
+    }
+  }
+  return std::make_pair(head, first);
+}
+
+template <typename I, typename N, typename Compare>
+// I is Linked Iterator
+// N is Integral
+// stable; sorts the n nodes starting at first; the result is terminated
+// by last. Runs of 2^counter_block_level nodes are insertion sorted and
+// enter the counter at their level, so the counter sees one add in 16.
+I mergesort_linked_n(I first, N n, I last, Compare cmp) {
+  mergesort_linked_operation<I, Compare> op(last, cmp);
+  fixed_binary_counter<mergesort_linked_operation<I, Compare> > counter(op, last);
+  const N run_size = N(1) << counter_block_level;
+  while (n >= run_size) {
+    std::pair<I, I> run = insertion_sort_linked_n(first, run_size, last, cmp);
+    counter.add_at_level(run.first, counter_block_level);
+    first = run.second;
+    n -= run_size;
+  }
+  I result = counter.reduce();
+  if (n == N(0)) return result;
+  I tail = insertion_sort_linked_n(first, n, last, cmp).first;
+  return result == last ? tail : op(result, tail);
+}
+
+template <typename I, typename Compare>
+// I is Linked Iterator
+inline
+I mergesort_linked(I first, I last, Compare cmp) {
+  return mergesort_linked_n(first, std::size_t(std::distance(first, last)), last, cmp);
+}
+
+template <typename I, typename Compare>
+// I is Linked Iterator
+// sorts the segment of n nodes starting at *head in place of its head
+struct mergesort_linked_segment
+{
+  I* head;
+  std::size_t n;
+  I nil;
+  Compare cmp;
+  mergesort_linked_segment(I& head, std::size_t n, I nil, const Compare& cmp) :
+    head(&head), n(n), nil(nil), cmp(cmp) {}
+  void operator()() { *head = mergesort_linked_n(*head, n, nil, cmp); }
+};
+
+template <typename I, typename Compare>
+// I is Linked Iterator
+// merges the non-empty sorted lists *left and right into *left; on equal
+// elements the left list goes first
+struct merge_linked_segments
+{
+  I* left;
+  I right;
+  I nil;
+  Compare cmp;
+  merge_linked_segments(I& left, I right, I nil, const Compare& cmp) :
+    left(&left), right(right), nil(nil), cmp(cmp) {}
+  void operator()() { *left = merge_linked_non_empty(*left, nil, right, nil, cmp).first; }
+};
+
+template <typename I, typename Compare>
+// I is Linked Iterator
+// stable; one pass finds the starts of threads segments, each sorted by
+// its own thread with its own binary counter, then rounds of merges of
+// adjacent sorted segments, all the merges of a round running at once.
+// Nodes are only relinked, never copied.
+I mergesort_linked_parallel(I first, I last, Compare cmp, unsigned threads) {
+  std::size_t n = std::distance(first, last);
+  if (threads == 0) threads = 1;
+  if (n < threads) threads = unsigned(n);
+  if (threads <= 1) return mergesort_linked_n(first, n, last, cmp);
+
+  std::vector<I> heads;
+  std::vector<std::size_t> sizes;
+  heads.reserve(threads);
+  for (unsigned t = 0; t < threads; ++t) {
+    std::size_t size = n * (t + 1) / threads - n * t / threads;
+    heads.push_back(first);
+    sizes.push_back(size);
+    if (t + 1 != threads) std::advance(first, size);
+  }
+
+  std::vector<std::thread> workers;
+  for (unsigned t = 1; t < threads; ++t) {
+    workers.push_back(std::thread(
+      mergesort_linked_segment<I, Compare>(heads[t], sizes[t], last, cmp)));
+  }
+  mergesort_linked_segment<I, Compare>(heads[0], sizes[0], last, cmp)();
+  for (std::size_t t = 0; t < workers.size(); ++t) workers[t].join();
+
+  // segment i merges with segment i + step into heads[i]
+  for (std::size_t step = 1; step < heads.size(); step *= 2) {
+    workers.clear();
+    for (std::size_t i = 2 * step; i + step < heads.size(); i += 2 * step) {
+      workers.push_back(std::thread(
+        merge_linked_segments<I, Compare>(heads[i], heads[i + step], last, cmp)));
+    }
+    merge_linked_segments<I, Compare>(heads[0], heads[step], last, cmp)();
+    for (std::size_t t = 0; t < workers.size(); ++t) workers[t].join();
+  }
+  return heads[0];
+}
+
+template <typename I, typename Compare>
+// I is Linked Iterator
+struct mergesort_linked_block
+{
+  I nil;
+  Compare cmp;
+  mergesort_linked_block(I nil, const Compare& cmp) : nil(nil), cmp(cmp) {}
+  template <typename N>
+  I operator()(I first, N n) { return mergesort_linked_n(first, n, nil, cmp); }
+};
+
+template <typename I, typename Compare>
+// I is Linked Iterator
+// stable; mergesort_linked on the parallel reduction engine: the blocks
+// are sorted by separate threads and merged in the same order the serial
+// binary counter would merge them, so the result is that of
+// mergesort_linked. The final merges run in the calling thread;
+// mergesort_linked_parallel does them in a parallel tree instead.
+I mergesort_linked_parallel_balanced(I first, I last, Compare cmp, unsigned threads) {
+  std::size_t n = std::distance(first, last);
+  return reduce_balanced_parallel(first, n,
+                                  mergesort_linked_block<I, Compare>(last, cmp),
+                                  mergesort_linked_operation<I, Compare>(last, cmp),
+                                  last, threads);
+}
+
+template <typename I, typename Compare>
+// I is Linked Iterator
+// natural mergesort: the list is cut into maximal runs, ascending or
+// strictly descending (reversed, which keeps it stable), and a run of
+// length in [2^k, 2^(k+1)) enters the counter at level k. Any partial
+// results below k, all older than the run, are merged in front of it
+// first. A sorted or reverse sorted list takes n comparisons (the first
+// pair is compared twice) and no merges.
+I mergesort_linked_natural(I first, I last, Compare cmp) {
+  mergesort_linked_operation<I, Compare> op(last, cmp);
+  fixed_binary_counter<mergesort_linked_operation<I, Compare> > counter(op, last);
+  while (first != last) {
+    I head = first;
+    I back = first++;
+    std::size_t length = 1;
+    if (first != last && cmp(*first, *back)) {
+      while (first != last && cmp(*first, *back)) {
+        back = first++;
+        ++length;
+      }
+      head = reverse_linked(head, first, last);
+    } else {
+      while (first != last && !cmp(*first, *back)) {
+        back = first++;
+        ++length;
+      }
+      set_successor(back, last);
+    }
+    int level = 0;
+    while (length >> (level + 1)) ++level;
+    if (!counter.empty_below(level)) head = op(counter.take_below(level), head);
+    counter.add_at_level(head, level);
   }
   return counter.reduce();
 }
 
+template <typename Compare>
+// orders (key, node) pairs by their keys only
+struct compare_first
+{
+  Compare cmp;
+  compare_first(const Compare& cmp) : cmp(cmp) {}
+  template <typename Pair>
+  bool operator()(const Pair& x, const Pair& y) const { return cmp(x.first, y.first); }
+};
+
+template <typename T>
+struct identity_key
+{
+  const T& operator()(const T& x) const { return x; }
+};
+
+template <typename I, typename Key, typename Compare>
+// I is Linked Iterator
+// Key is a function from ValueType(I) to a semiregular type
+// Compare is a StrictWeakOrdering on the keys
+// stable; one traversal gathers the (key, node) pairs into a vector, the
+// vector is sorted and one pass over it relinks the nodes. Only the
+// traversal and the relinking touch the nodes, instead of every merge
+// pass, at the cost of a copy of every key.
+I sort_linked_gather_key(I first, I last, Key key, Compare cmp) {
+  if (first == last) return last;
+  typedef typename std::decay<decltype(key(*first))>::type K;
+  std::vector<std::pair<K, I> > nodes;
+  while (first != last) {
+    nodes.push_back(std::make_pair(key(*first), first));
+    ++first;
+  }
+  std::stable_sort(nodes.begin(), nodes.end(), compare_first<Compare>(cmp));
+  for (std::size_t i = 1; i < nodes.size(); ++i) set_successor(nodes[i - 1].second, nodes[i].second);
+  set_successor(nodes.back().second, last);
+  return nodes.front().second;
+}
+
+template <typename I, typename Compare>
+// I is Linked Iterator
+// sort_linked_gather_key with the whole value as the key
+inline
+I sort_linked_gather(I first, I last, Compare cmp) {
+  typedef typename std::iterator_traits<I>::value_type T;
+  return sort_linked_gather_key(first, last, identity_key<T>(), cmp);
+}
+
+// sort_linked gathers lists of at least sort_linked_gather_min_size nodes
+// whose values take at most sort_linked_gather_max_value_size bytes. In
+// gather.cpp sort_linked_gather wins from 256 nodes for values up to 64
+// bytes, and breaks even at 1024 nodes for 128 bytes; for 256 bytes it
+// loses below 256K nodes, where copying the values costs more than the
+// merges.
+const std::size_t sort_linked_gather_min_size = 1024;
+const std::size_t sort_linked_gather_max_value_size = 128;
+
+template <typename I, typename Compare>
+// I is Linked Iterator
+// stable; sort_linked_gather or mergesort_linked, whichever is faster
+I sort_linked(I first, I last, Compare cmp) {
+  typedef typename std::iterator_traits<I>::value_type T;
+  if (sizeof(T) > sort_linked_gather_max_value_size) return mergesort_linked(first, last, cmp);
+  std::size_t n = 0;
+  I i = first;
+  while (i != last && n < sort_linked_gather_min_size) {
+    ++i;
+    ++n;
+  }
+  if (n < sort_linked_gather_min_size) return mergesort_linked_n(first, n, last, cmp);
+  return sort_linked_gather(first, last, cmp);
+}
+
 template <typename I0, typename I1>
 // requires I0 is Input Iterator
 // requires I1 is Singly Linked List Iterator
@@ -0,0 +1,65 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+#include <stdint.h>
+#include "algorithm.h"
+#include "timer.h"
+#include "list_pool.h"
+#include "mapped_list_pool.h"
+#include "list_algorithm.h"
+
+// compares building a sorted list at startup with reopening one that was
+// saved in a mapped_list_pool
+
+template <typename I>
+bool check_sorted(I first, I last, size_t n) {
+  return std::is_sorted(first, last) && size_t(std::distance(first, last)) == n;
+}
+
+int main(int argc, char* argv[]) {
+  // a 32 MB file: by default out of the source tree, and removed at the end
+  const char* path = argc > 1 ? argv[1] : "/tmp/list_pool.dat";
+  const size_t n(4 * 1024 * 1024);
+  std::vector<uint32_t> vec(n);
+  random_iota(vec.begin(), vec.end());
+  timer t;
+
+  {
+    t.start();
+    list_pool<uint32_t, uint32_t> pool(n);
+    list_pool<uint32_t, uint32_t>::iterator nil(pool);
+    list_pool<uint32_t, uint32_t>::iterator list = generate_list(vec.begin(), vec.end(), nil);
+    list = mergesort_linked(list, nil, std::less<uint32_t>());
+    double time = t.stop();
+    std::cout << "build and sort in memory: " << std::fixed << std::setprecision(0)
+              << time / 1000000. << " ms" << std::endl;
+  }
+  {
+    std::remove(path);
+    mapped_list_pool<uint32_t, uint32_t> pool(path);
+    pool.reserve(n);
+    mapped_list_pool<uint32_t, uint32_t>::iterator nil(pool);
+    mapped_list_pool<uint32_t, uint32_t>::iterator list = generate_list(vec.begin(), vec.end(), nil);
+    list = mergesort_linked(list, nil, std::less<uint32_t>());
+    pool.set_root(list.node);
+    pool.sync();
+  }
+  {
+    t.start();
+    mapped_list_pool<uint32_t, uint32_t> pool(path, true);
+    double open_time = t.stop();
+    t.start();
+    bool sorted = check_sorted(mapped_list_pool<uint32_t, uint32_t>::iterator(pool, pool.root()),
+                               mapped_list_pool<uint32_t, uint32_t>::iterator(pool), n);
+    double traversal_time = t.stop();
+    if (!sorted) std::cerr << "*** REOPENED LIST IS NOT SORTED! ***" << std::endl;
+    std::cout << "reopen read-only: " << std::fixed << std::setprecision(3)
+              << open_time / 1000000. << " ms, first traversal: "
+              << std::setprecision(0) << traversal_time / 1000000. << " ms" << std::endl;
+  }
+  if (argc <= 1) std::remove(path);
+}
@@ -0,0 +1,355 @@
+#ifndef MAPPED_LIST_POOL_H
+#define MAPPED_LIST_POOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <stdint.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// list_pool whose nodes live in a memory-mapped file.
+// Since lists are made of indices rather than pointers the file is the
+// pool: it is opened without any deserialization, and a read-only pool
+// can be shared by any number of processes.
+//
+// File format: a header (magic, version, sizes of T, N and the node,
+// size, capacity, free list and one root handle for the user) followed
+// by capacity nodes.
+
+// A read-only pool is mapped PROT_READ: the members that change it throw
+// std::logic_error instead of faulting, and writes through value() and
+// next() are not allowed.
+//
+// Requirements on T: semiregular and trivially copyable (no pointers).
+// Requirements on N: integral
+template <typename T, typename N = std::size_t>
+class mapped_list_pool {
+public:
+  typedef N list_type;
+  typedef T value_type;
+  typedef std::size_t size_type;
+
+  static const uint32_t version = 1;
+
+private:
+
+  struct node_t {
+    T value;
+    list_type next;
+  };
+
+  struct header_t {
+    char magic[8];
+    uint32_t version;
+    uint32_t value_size;
+    uint32_t index_size;
+    uint32_t node_size;
+    uint64_t size;
+    uint64_t capacity;
+    list_type free_list;
+    list_type root;
+  };
+
+  int fd;
+  bool read_only;
+  void* base;
+  size_type mapped_bytes;
+
+  // not copyable: the mapping is owned
+  mapped_list_pool(const mapped_list_pool&);
+  mapped_list_pool& operator=(const mapped_list_pool&);
+
+  header_t& header() {
+    return *static_cast<header_t*>(base);
+  }
+  const header_t& header() const {
+    return *static_cast<const header_t*>(base);
+  }
+
+  // the nodes start at the first multiple of their alignment after the header
+  static const size_type nodes_offset =
+    (sizeof(header_t) + alignof(node_t) - 1) / alignof(node_t) * alignof(node_t);
+
+  node_t* nodes() const {
+    return reinterpret_cast<node_t*>(static_cast<char*>(base) + nodes_offset);
+  }
+
+  node_t& node(list_type x) {
+    return nodes()[x - 1];
+  }
+  const node_t& node(list_type x) const {
+    return nodes()[x - 1];
+  }
+
+  static size_type file_size(size_type n) {
+    return nodes_offset + n * sizeof(node_t);
+  }
+
+  // maps the first bytes of the file in place of the current mapping,
+  // which is only unmapped once the new one exists
+  void map(size_type bytes) {
+    int protection = read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+    void* p = mmap(0, bytes, protection, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) throw std::runtime_error("mapped_list_pool: mmap failed");
+    unmap();
+    base = p;
+    mapped_bytes = bytes;
+  }
+
+  void unmap() {
+    if (base) munmap(base, mapped_bytes);
+    base = 0;
+  }
+
+  list_type new_list() {
+    if (size() == max_size()) throw std::length_error("mapped_list_pool: index overflow");
+    if (size() == capacity()) reserve(std::min(capacity() < 8 ? 16 : 2 * capacity(), max_size()));
+    return list_type(++header().size);
+  }
+
+  void check_writable() const {
+    if (read_only) throw std::logic_error("mapped_list_pool: the pool is read-only");
+  }
+
+  // closes the file and unmaps it if the constructor does not finish
+  struct open_guard {
+    mapped_list_pool* pool;
+    open_guard(mapped_list_pool& pool) : pool(&pool) {}
+    ~open_guard() {
+      if (!pool) return;
+      pool->unmap();
+      close(pool->fd);
+    }
+    void release() { pool = 0; }
+  };
+
+ public:
+  // opens the pool stored at path, creating an empty one if the file is
+  // empty or missing (unless read_only)
+  mapped_list_pool(const char* path, bool read_only = false) :
+    read_only(read_only), base(0), mapped_bytes(0) {
+    fd = open(path, read_only ? O_RDONLY : O_RDWR | O_CREAT, 0644);
+    if (fd < 0) throw std::runtime_error("mapped_list_pool: cannot open file");
+    open_guard guard(*this);
+    struct stat st;
+    if (fstat(fd, &st) != 0) throw std::runtime_error("mapped_list_pool: cannot read file size");
+    if (st.st_size == 0) {
+      if (read_only) throw std::runtime_error("mapped_list_pool: empty file");
+      if (ftruncate(fd, file_size(0)) != 0) throw std::runtime_error("mapped_list_pool: cannot grow file");
+      map(file_size(0));
+      header_t h;
+      std::memset(&h, 0, sizeof(h));
+      std::memcpy(h.magic, "LISTPOOL", 8);
+      h.version = version;
+      h.value_size = sizeof(T);
+      h.index_size = sizeof(N);
+      h.node_size = sizeof(node_t);
+      h.free_list = end();
+      h.root = end();
+      header() = h;
+      guard.release();
+      return;
+    }
+    if (size_type(st.st_size) < file_size(0)) throw std::runtime_error("mapped_list_pool: not a pool");
+    map(st.st_size);
+    const header_t& h = header();
+    if (std::memcmp(h.magic, "LISTPOOL", 8) != 0 ||
+        h.version != version ||
+        h.value_size != sizeof(T) ||
+        h.index_size != sizeof(N) ||
+        h.node_size != sizeof(node_t)) {
+      throw std::runtime_error("mapped_list_pool: incompatible file");
+    }
+    // a truncated or corrupt file must not send indices out of the mapping
+    if (h.capacity > max_size() ||
+        size_type(st.st_size) < file_size(h.capacity) ||
+        h.size > h.capacity ||
+        uint64_t(h.free_list) > h.size ||
+        uint64_t(h.root) > h.size) {
+      throw std::runtime_error("mapped_list_pool: corrupt file");
+    }
+    guard.release();
+  }
+
+  ~mapped_list_pool() {
+    unmap();
+    close(fd);
+  }
+
+  // flushes the pool to the file
+  void sync() {
+    if (msync(base, mapped_bytes, MS_SYNC) != 0) throw std::runtime_error("mapped_list_pool: cannot sync file");
+  }
+
+  list_type end() const {
+    return list_type(0);
+  }
+
+  bool is_end(list_type x) const {
+    return x == end();
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  size_type size() const {
+    return header().size;
+  }
+
+  size_type capacity() const {
+    return header().capacity;
+  }
+
+  // the number of nodes addressable by list_type
+  size_type max_size() const {
+    return size_type(std::min(uint64_t(std::numeric_limits<list_type>::max()),
+                              uint64_t(std::numeric_limits<size_type>::max() / sizeof(node_t))));
+  }
+
+  void reserve(size_type n) {
+    check_writable();
+    if (n <= capacity()) return;
+    if (n > max_size()) throw std::length_error("mapped_list_pool: index overflow");
+    if (ftruncate(fd, file_size(n)) != 0) throw std::runtime_error("mapped_list_pool: cannot grow file");
+    map(file_size(n));
+    header().capacity = n;
+  }
+
+  // a handle saved with the pool, e.g. the head of its main list
+  list_type root() const {
+    return header().root;
+  }
+
+  void set_root(list_type x) {
+    check_writable();
+    header().root = x;
+  }
+
+  T& value(list_type x) {
+    return node(x).value;
+  }
+
+  const T& value(list_type x) const {
+    return node(x).value;
+  }
+
+  list_type& next(list_type x) {
+    return node(x).next;
+  }
+  const list_type& next(list_type x) const {
+    return node(x).next;
+  }
+
+  list_type free(list_type x) {
+    check_writable();
+    list_type tail = next(x);
+    next(x) = header().free_list;
+    header().free_list = x;
+    return tail;
+  }
+
+  list_type free(list_type front, list_type back) {
+    check_writable();
+    if (is_end(front)) return end();
+    list_type tail = next(back);
+    next(back) = header().free_list;
+    header().free_list = front;
+    return tail;
+  }
+
+  list_type allocate(const T& val, list_type tail) {
+    check_writable();
+    list_type list = header().free_list;
+    if (is_end(list)) {
+      list = new_list();
+    } else {
+      header().free_list = next(list);
+    }
+    value(list) = val;
+    next(list) = tail;
+    return list;
+  }
+
+  struct iterator {
+    typedef typename mapped_list_pool::value_type value_type;
+    typedef typename mapped_list_pool::list_type difference_type;
+    typedef std::forward_iterator_tag iterator_category;
+
+    typedef value_type& reference;
+    typedef value_type* pointer;
+
+    mapped_list_pool* pool;
+    typename mapped_list_pool::list_type node;
+
+    iterator() {} // creates a partially formed value
+    iterator(mapped_list_pool& p, typename mapped_list_pool::list_type node) :
+      pool(&p), node(node) {}
+    iterator(mapped_list_pool& p) : pool(&p), node(p.end()) {}
+
+    reference operator*() const {
+      return pool->value(node);
+    }
+
+    pointer operator->() const {
+      return &**this;
+    }
+
+    iterator& operator++() {
+      node = pool->next(node);
+      return *this;
+    }
+
+    iterator operator++(int) {
+      iterator tmp(*this);
+      ++*this;
+      return tmp;
+    }
+
+    friend
+    bool operator==(const iterator& x, const iterator& y) {
+      // assert(x.pool == y.pool);
+      return x.node == y.node;
+    }
+
+    friend
+    bool operator!=(const iterator& x, const iterator& y) {
+      return !(x == y);
+    }
+
+    // extends the interface to Linked Iterator:
+
+    friend
+    void set_successor(iterator x, iterator y) {
+      // assert(x.p == y.p)
+      x.pool->next(x.node) = y.node;
+    }
+
+    // extend the interface to Singly Linked List Iterator:
+
+    friend
+    void push_front(iterator& x, const T& value) {
+      x.node = x.pool->allocate(value, x.node);
+    }
+
+    friend
+    void push_back(iterator& x, const T& value) {
+      typename mapped_list_pool::list_type tmp = x.pool->allocate(value, x.pool->next(x.node));
+      x.pool->next(x.node) = tmp;
+    }
+
+    friend
+    void free(iterator& x) {
+      x.pool->free(x.node);
+    }
+  };
+};
+
+#endif
@@ -0,0 +1,74 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <cstdlib>
+#include <vector>
+#include "timer.h"
+#include "list_pool.h"
+#include "list_algorithm.h"
+
+// merging two sorted lists of n ints: merge_linked_simple,
+// merge_linked_non_empty and merge_linked_non_empty_branchless, ns per
+// node. Random keys switch lists every other node and mispredict; clustered
+// keys alternate in runs of 64 and are predictable.
+
+typedef list_pool<int, uint32_t> pool_type;
+typedef pool_type::iterator I;
+
+enum merge_kind { simple, non_empty, branchless };
+
+double time_merge(const std::vector<int>& a, const std::vector<int>& b, merge_kind kind) {
+  const size_t repeat = std::max(size_t(1), (size_t(1) << 24) / (a.size() + b.size()));
+  double time = 0;
+  bool sorted = true;
+  for (size_t r = 0; r < repeat; ++r) {
+    pool_type pool(a.size() + b.size());
+    I nil(pool);
+    I first1 = generate_list(a.begin(), a.end(), nil);
+    I first2 = generate_list(b.begin(), b.end(), nil);
+    I list;
+    timer t;
+    t.start();
+    if (kind == simple) list = merge_linked_simple(first1, nil, first2, nil, std::less<int>());
+    else if (kind == non_empty) list = merge_linked_non_empty(first1, nil, first2, nil, std::less<int>()).first;
+    else list = merge_linked_non_empty_branchless(first1, nil, first2, nil, std::less<int>()).first;
+    time += t.stop();
+    sorted = sorted && std::is_sorted(list, nil);
+  }
+  if (!sorted) std::cout << " *** WRONG ***";
+  return time / double(repeat * (a.size() + b.size()));
+}
+
+// two sorted lists of n values taken from 2n sorted values: at random, or
+// in alternating runs of run_size
+void split(std::vector<int>& a, std::vector<int>& b, size_t n, size_t run_size) {
+  a.clear();
+  b.clear();
+  for (size_t i = 0; i < 2 * n; ++i) {
+    bool first = run_size == 0 ? (std::rand() & 1) : (i / run_size) % 2 == 0;
+    (first ? a : b).push_back(int(i));
+  }
+  if (a.empty()) a.push_back(-1);
+  if (b.empty()) b.push_back(-1);
+  std::sort(a.begin(), a.end());
+  std::sort(b.begin(), b.end());
+}
+
+int main() {
+  std::cout << std::setw(10) << "n" << std::setw(10) << "input"
+            << std::setw(10) << "simple" << std::setw(12) << "non_empty"
+            << std::setw(12) << "branchless" << std::endl;
+  std::vector<int> a, b;
+  for (size_t n = 1024; n <= 4 * 1024 * 1024; n *= 32) {
+    for (size_t run_size = 0; run_size <= 64; run_size += 64) {
+      split(a, b, n, run_size);
+      std::cout << std::setw(10) << n << std::setw(10) << (run_size ? "clustered" : "random")
+                << std::fixed << std::setprecision(2)
+                << std::setw(10) << time_merge(a, b, simple)
+                << std::setw(12) << time_merge(a, b, non_empty)
+                << std::setw(12) << time_merge(a, b, branchless) << std::endl;
+    }
+  }
+}
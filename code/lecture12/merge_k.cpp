@@ -0,0 +1,100 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <vector>
+#include "timer.h"
+#include "list_pool.h"
+#include "list_algorithm.h"
+
+// merging k sorted lists into one: merge_linked_k with its loser tree
+// against rounds of pairwise merge_linked_non_empty, which touch every
+// node log2(k) times instead of once
+
+struct counting_less
+{
+  size_t* count;
+  bool operator()(int x, int y) const {
+    ++*count;
+    return x < y;
+  }
+};
+
+typedef list_pool<int, uint32_t> pool_type;
+typedef pool_type::iterator I;
+
+// k sorted lists of about n / k nodes each, with their nodes interleaved
+// in the pool the way they would be after sorting runs of random data
+std::vector<I> generate_lists(pool_type& pool, size_t n, size_t k) {
+  std::vector<int> values(n);
+  for (size_t i = 0; i < n; ++i) values[i] = std::rand();
+  std::vector<size_t> owner(n);
+  for (size_t i = 0; i < n; ++i) owner[i] = i % k;
+  std::random_shuffle(owner.begin(), owner.end());
+  std::vector<std::vector<int> > parts(k);
+  for (size_t i = 0; i < n; ++i) parts[owner[i]].push_back(values[i]);
+  I nil(pool);
+  std::vector<I> heads(k, nil);
+  std::vector<I> tails(k, nil);
+  for (size_t j = 0; j < k; ++j) std::sort(parts[j].begin(), parts[j].end());
+  std::vector<size_t> next(k, 0);
+  for (size_t i = 0; i < n; ++i) {
+    size_t j = owner[i];
+    int x = parts[j][next[j]++];
+    if (heads[j] == nil) {
+      push_front(heads[j], x);
+      tails[j] = heads[j];
+    } else {
+      push_back(tails[j], x);
+      ++tails[j];
+    }
+  }
+  return heads;
+}
+
+I merge_pairwise(std::vector<I> heads, I nil, counting_less cmp) {
+  for (size_t step = 1; step < heads.size(); step *= 2) {
+    for (size_t i = 0; i + step < heads.size(); i += 2 * step) {
+      if (heads[i] == nil) heads[i] = heads[i + step];
+      else if (heads[i + step] != nil)
+        heads[i] = merge_linked_non_empty(heads[i], nil, heads[i + step], nil, cmp).first;
+    }
+  }
+  return heads.empty() ? nil : heads[0];
+}
+
+I merge_tournament(std::vector<I> heads, I nil, counting_less cmp) {
+  return merge_linked_k(heads.begin(), heads.end(), nil, cmp);
+}
+
+void time_merge(I (*merge)(std::vector<I>, I, counting_less), size_t n, size_t k) {
+  pool_type pool;
+  pool.reserve(n);
+  std::srand(k);
+  std::vector<I> heads = generate_lists(pool, n, k);
+  I nil(pool);
+  size_t comparisons = 0;
+  counting_less cmp = {&comparisons};
+  timer t;
+  t.start();
+  I list = merge(heads, nil, cmp);
+  double time = t.stop();
+  bool sorted = std::is_sorted(list, nil) && size_t(std::distance(list, nil)) == n;
+  std::cout << std::setw(12) << std::fixed << std::setprecision(1) << time / double(n)
+            << std::setw(8) << std::setprecision(2) << double(comparisons) / double(n)
+            << (sorted ? "" : " *** WRONG ***");
+}
+
+int main() {
+  const size_t n(4 * 1000 * 1000);
+  std::cout << n << " nodes, ns and comparisons per node" << std::endl;
+  std::cout << std::setw(8) << "k" << std::setw(20) << "pairwise"
+            << std::setw(20) << "merge_linked_k" << std::endl;
+  for (size_t k = 2; k <= 4096; k *= 4) {
+    std::cout << std::setw(8) << k;
+    time_merge(merge_pairwise, n, k);
+    time_merge(merge_tournament, n, k);
+    std::cout << std::endl;
+  }
+}
@@ -1,3 +1,9 @@
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 
 template <typename I, typename Compare>
 // I is a linked forward iterator
@@ -46,3 +52,132 @@ merge_linked_non_empty(I first1, I last1, I first2, I last2, Compare cmp) {
   set_successor(tail, first1);
   return std::make_pair(head, std::make_pair(first1, last1));
 }
+
+template <typename I, typename Compare>
+// I is a linked forward iterator
+// a loser tree over the heads of k sorted lists, all terminated by last;
+// players are list indices and an exhausted list loses to any other
+class loser_tree_linked
+{
+private:
+  std::vector<I> heads;
+  std::vector<std::size_t> tree; // tree[0] is the winner, tree[1..k) losers
+  I last;
+  Compare cmp;
+
+  // on equal heads the list with the smaller index wins, for stability
+  bool beats(std::size_t a, std::size_t b) {
+    if (heads[b] == last) return true;
+    if (heads[a] == last) return false;
+    return a < b ? !cmp(*heads[b], *heads[a]) : cmp(*heads[a], *heads[b]);
+  }
+
+public:
+  template <typename I0>
+  // I0 is a ForwardIterator and ValueType(I0) == I
+  loser_tree_linked(I0 first, I0 last_list, I last, const Compare& cmp) :
+    heads(first, last_list), tree(heads.size()), last(last), cmp(cmp) {
+    std::size_t k = heads.size();
+    // winners of the subtrees; leaf i sits at position k + i
+    std::vector<std::size_t> winners(2 * k);
+    for (std::size_t i = 0; i < k; ++i) winners[k + i] = i;
+    for (std::size_t j = k - 1; j >= 1; --j) {
+      std::size_t a = winners[2 * j];
+      std::size_t b = winners[2 * j + 1];
+      if (beats(b, a)) std::swap(a, b);
+      winners[j] = a;
+      tree[j] = b;
+    }
+    tree[0] = winners[1];
+  }
+
+  bool empty() const { return heads[tree[0]] == last; }
+
+  // returns: the smallest head, after which its list moves on
+  I pop() {
+    // precondition: !empty()
+    std::size_t i = tree[0];
+    I x = heads[i]++;
+    for (std::size_t j = (heads.size() + i) / 2; j >= 1; j /= 2) {
+      if (beats(tree[j], i)) std::swap(tree[j], i);
+    }
+    tree[0] = i;
+    return x;
+  }
+};
+
+template <typename I0, typename I, typename Compare>
+// I0 is a ForwardIterator and ValueType(I0) == I
+// I is a linked forward iterator
+// merges the sorted lists whose heads are in [first, last_list), all
+// terminated by last, in one pass with about log2(k) comparisons per
+// node; stable, with earlier lists first on equal elements
+I merge_linked_k(I0 first, I0 last_list, I last, Compare cmp) {
+  if (first == last_list) return last;
+  loser_tree_linked<I, Compare> tree(first, last_list, last, cmp);
+  if (tree.empty()) return last;
+  I head = tree.pop();
+  I tail = head;
+  while (!tree.empty()) {
+    I x = tree.pop();
+    set_successor(tail, x);
+    tail = x;
+  }
+  set_successor(tail, last);
+  return head;
+}
+
+template <typename P, typename Compare>
+// P is list_pool with an arithmetic value_type
+// merge_linked_non_empty on the indices of a pool, for arithmetic keys,
+// without a data-dependent branch: the keys of both heads stay in
+// registers, the winner, the heads and the keys are conditional moves,
+// and the successor of the tail is written every time. The only branch
+// is on the end of the winning list. Working on indices keeps the selects
+// to single registers; on iterators, which carry the pool, compilers turn
+// them back into branches.
+std::pair<typename P::list_type,
+          std::pair<typename P::list_type, typename P::list_type> >
+merge_linked_non_empty_branchless(P& pool,
+                                  typename P::list_type first1, typename P::list_type last1,
+                                  typename P::list_type first2, typename P::list_type last2,
+                                  Compare cmp) {
+  typedef typename P::value_type T;
+  typedef typename P::list_type N;
+  static_assert(std::is_arithmetic<T>::value, "keys must be arithmetic");
+  T key1 = pool.value(first1);
+  T key2 = pool.value(first2);
+  bool take2 = cmp(key2, key1);
+  N head = take2 ? first2 : first1;
+  N tail = head;
+  while (true) {
+    N next = pool.next(tail);
+    if (next == (take2 ? last2 : last1)) break;
+    T key = pool.value(next);
+    first1 = take2 ? first1 : next;
+    first2 = take2 ? next : first2;
+    key1 = take2 ? key1 : key;
+    key2 = take2 ? key : key2;
+    take2 = cmp(key2, key1);
+    N x = take2 ? first2 : first1;
+    pool.next(tail) = x;
+    tail = x;
+  }
+  N rest = take2 ? first1 : first2;
+  pool.next(tail) = rest;
+  return std::make_pair(head, std::make_pair(rest, take2 ? last1 : last2));
+}
+
+template <typename I, typename Compare>
+// I is list_pool<T, N>::iterator with T arithmetic
+// merge_linked_non_empty through the branchless merge of the indices
+std::pair<I, std::pair<I, I> >
+merge_linked_non_empty_branchless(I first1, I last1, I first2, I last2, Compare cmp) {
+  typedef decltype(first1.node) N;
+  std::pair<N, std::pair<N, N> > result =
+    merge_linked_non_empty_branchless(*first1.pool, first1.node, last1.node,
+                                      first2.node, last2.node, cmp);
+  return std::make_pair(I(*first1.pool, result.first),
+                        std::make_pair(I(*first1.pool, result.second.first),
+                                       I(*first1.pool, result.second.second)));
+}
@@ -0,0 +1,679 @@
+#ifndef MIN_ELEMENT1_2_H
+#define MIN_ELEMENT1_2_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <stdint.h>
+#include "algorithm.h"
+#include "binary_counter.h"
+#include "list_pool.h"
+#include "parallel_binary_counter.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// the counter holds at most one loser list per slot and the list in slot k
+// has k nodes, so fewer than 64 * 63 / 2 nodes are ever live and a 16 bit
+// index addresses any pool built by the tournaments below
+typedef list_pool_index<64 * 63 / 2>::type min_element1_2_index;
+
+template <typename T, typename N>
+inline
+std::pair<T, N>
+combine(const std::pair<T, N>& x,
+	const std::pair<T, N>& y,
+	list_pool<T, N>& pool) {
+  free_list(pool, y.second);
+  return std::make_pair(x.first, pool.allocate(y.first, x.second));
+} 
+
+template <typename T, typename N, typename Compare>
+class op_min1_2 
+{
+private:
+  Compare cmp;
+  list_pool<T, N>* p;
+public:
+  typedef typename list_pool<T, N>::list_type list_type;
+  typedef std::pair<T, list_type> argument_type;
+  op_min1_2(const Compare& cmp, list_pool<T, N>& pool) 
+    : cmp(cmp), p(&pool) {}
+  argument_type operator()(const argument_type& x, 
+			   const argument_type& y) {
+    return cmp(y.first, x.first) ? combine(y, x, *p) : combine(x, y, *p);
+  }
+};
+
+template <typename Compare>
+class compare_dereference
+{
+private:
+  Compare cmp;
+public:
+  compare_dereference(const Compare& cmp) : cmp(cmp) {}
+  template <typename I>
+  bool operator() (const I& x, const I& y) const {
+    return cmp(*x, *y);
+  }
+};
+
+template <typename I, typename Compare>
+// requires I is a ForwardIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+// and pool is scratch space: every node is back on its free list on return,
+// so a pool reused across calls stops allocating once it has grown
+std::pair<I, I> min_element1_2(I first, I last, Compare cmp,
+                               list_pool<I, min_element1_2_index>& pool) {
+  if (first == last || successor(first) == last) {
+    return std::make_pair(first, last);
+  }
+
+  typedef op_min1_2<I, min_element1_2_index, compare_dereference<Compare> > op_type;
+
+  compare_dereference<Compare> cmp_deref(cmp);
+  op_type op(cmp_deref, pool);
+  fixed_binary_counter<op_type> counter(op, std::make_pair(last, pool.end()));
+
+  // pairs are played before they reach the counter, entering at slot 1
+  while (first != last) {
+    typename op_type::argument_type x(first++, pool.end());
+    if (first == last) {
+      counter.add(x);
+      break;
+    }
+    counter.add_at_level(op(x, std::make_pair(first++, pool.end())), 1);
+  }
+  typename op_type::argument_type min1_list = counter.reduce();
+  I min1 = min1_list.first;
+  I min2 = pool.value(min_element_list(pool, min1_list.second, cmp_deref));
+  free_list(pool, min1_list.second);
+  return std::make_pair(min1, min2);
+}
+
+template <typename I, typename Compare>
+// requires I is a ForwardIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+std::pair<I, I> min_element1_2(I first, I last, Compare cmp) {
+  list_pool<I, min_element1_2_index> pool;
+  pool.reserve(256);
+  return min_element1_2(first, last, cmp, pool);
+}
+
+/****************** parallel algorithm ****************************/
+
+template <typename I, typename Compare>
+// requires I is a ForwardIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+// the tournament of min_element1_2 on a block, with the losers to the
+// winner copied out of the block's own pool, oldest first
+struct min_element1_2_block
+{
+  typedef std::pair<I, std::vector<I> > result_type;
+  I last;
+  Compare cmp;
+  min_element1_2_block(I last, const Compare& cmp) : last(last), cmp(cmp) {}
+
+  template <typename N>
+  result_type operator()(I first, N n) {
+    typedef op_min1_2<I, min_element1_2_index, compare_dereference<Compare> > op_type;
+    list_pool<I, min_element1_2_index> pool;
+    pool.reserve(256);
+    op_type op(compare_dereference<Compare>(cmp), pool);
+    fixed_binary_counter<op_type> counter(op, std::make_pair(last, pool.end()));
+    while (n != N(0)) {
+      counter.add(std::make_pair(first++, pool.end()));
+      --n;
+    }
+    typename op_type::argument_type min1_list = counter.reduce();
+    result_type result(min1_list.first, std::vector<I>());
+    for (min_element1_2_index x = min1_list.second; !pool.is_end(x); x = pool.next(x)) {
+      result.second.push_back(pool.value(x));
+    }
+    std::reverse(result.second.begin(), result.second.end());
+    return result;
+  }
+};
+
+template <typename I, typename Compare>
+// combines block results the way op_min1_2 combines single elements;
+// the loser lists are oldest first, so the loser is appended, and the
+// list of the winner is taken over, not copied: the counters never use
+// a value again once it has been combined
+class op_min1_2_blocks
+{
+private:
+  Compare cmp;
+public:
+  typedef std::pair<I, std::vector<I> > argument_type;
+  op_min1_2_blocks(const Compare& cmp) : cmp(cmp) {}
+  argument_type operator()(argument_type& x, argument_type& y) {
+    bool y_wins = cmp(y.first, x.first);
+    argument_type& winner = y_wins ? y : x;
+    argument_type result;
+    result.first = winner.first;
+    result.second.swap(winner.second);
+    result.second.push_back(y_wins ? x.first : y.first);
+    return result;
+  }
+};
+
+template <typename I, typename Compare>
+// requires I is a ForwardIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+// same result as min_element1_2, with the tournament run by threads
+std::pair<I, I> min_element1_2_parallel(I first, I last, Compare cmp, unsigned threads) {
+  if (first == last || successor(first) == last) {
+    return std::make_pair(first, last);
+  }
+  typedef std::pair<I, std::vector<I> > result_type;
+  compare_dereference<Compare> cmp_deref(cmp);
+  result_type min1_list = 
+    reduce_balanced_parallel(first, std::size_t(std::distance(first, last)),
+			     min_element1_2_block<I, Compare>(last, cmp),
+			     op_min1_2_blocks<I, compare_dereference<Compare> >(cmp_deref),
+			     result_type(last, std::vector<I>()), threads);
+  // newest first, as min_element1_2 searches its list
+  I min2 = *std::min_element(min1_list.second.rbegin(), min1_list.second.rend(), cmp_deref);
+  return std::make_pair(min1_list.first, min2);
+}
+
+/****************** stable algorithm for random access ****************************/
+
+
+template <typename Compare>
+class compare_dereference_random_access
+{
+private:
+  Compare cmp;
+public:
+  compare_dereference_random_access(const Compare& cmp) : cmp(cmp) {}
+  template <typename I>
+  bool operator() (const I& x, const I& y) const {
+    if (x < y) {
+      return !cmp(*y, *x);
+    } else {
+      return cmp(*x, *y);
+    }
+  }
+};
+
+template <typename I, typename Compare>
+// requires I is a RandomAccessIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+// and pool is scratch space, as for min_element1_2
+std::pair<I, I> min_element1_2_stable_random_access(I first, I last, Compare cmp,
+                                                    list_pool<I, min_element1_2_index>& pool) {
+  if (first == last || successor(first) == last) {
+    return std::make_pair(first, last);
+  }
+
+  typedef op_min1_2<I, min_element1_2_index, compare_dereference<Compare> > op_type;
+
+  compare_dereference<Compare> cmp_deref(cmp);
+  compare_dereference_random_access<Compare> cmp_deref_stable(cmp);
+  op_type op(cmp_deref, pool);
+  fixed_binary_counter<op_type> counter(op, std::make_pair(last, pool.end()));
+
+  while (first != last) counter.add(std::make_pair(first++, pool.end()));
+  typename op_type::argument_type min1_list = counter.reduce();
+  I min1 = min1_list.first;
+  I min2 = pool.value(min_element_list(pool, min1_list.second, cmp_deref_stable));
+  free_list(pool, min1_list.second);
+  return std::make_pair(min1, min2);
+}
+
+template <typename I, typename Compare>
+// requires I is a RandomAccessIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+std::pair<I, I> min_element1_2_stable_random_access(I first, I last, Compare cmp) {
+  list_pool<I, min_element1_2_index> pool;
+  pool.reserve(256);
+  return min_element1_2_stable_random_access(first, last, cmp, pool);
+}
+
+
+/****************** stable case best algorithm ****************************/
+
+template <typename T, typename N, typename Compare>
+class op_min1_2_stable 
+{
+private:
+  Compare cmp;
+  list_pool<T, N>* p;
+public:
+  typedef typename list_pool<T, N>::list_type list_type;
+  typedef std::pair<T, std::pair<list_type, list_type> > argument_type;
+
+  op_min1_2_stable(const Compare& cmp, list_pool<T, N>& pool) : cmp(cmp), p(&pool) {}
+
+  argument_type operator()(const argument_type& x, 
+                           const argument_type& y) {
+    if (!cmp(y.first, x.first)) {
+      p->free(y.second);
+      return std::make_pair(x.first, p->push_back(x.second, y.first));
+    } else {
+      p->free(x.second);
+      return std::make_pair(y.first, p->push_front(y.second, x.first));
+    }
+  }
+};
+
+template <typename I, typename Compare>
+// requires I is a ForwardIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+// and pool is scratch space, as for min_element1_2
+std::pair<I, I> min_element1_2_stable(I first, I last, Compare cmp,
+                                      list_pool<I, min_element1_2_index>& pool) {
+  if (first == last || successor(first) == last) {
+    return std::make_pair(first, last);
+  }
+
+  typedef typename list_pool<I, min_element1_2_index>::list_type list_type;
+  typedef op_min1_2_stable<I, min_element1_2_index, compare_dereference<Compare> > op_type;
+
+  compare_dereference<Compare> cmp_deref(cmp);
+  op_type op(cmp_deref, pool);
+  std::pair<list_type, list_type> ends(pool.end(), pool.end());
+  fixed_binary_counter<op_type> counter(op, std::make_pair(last, ends));
+
+  while (first != last) counter.add(std::make_pair(first++, ends));
+  typename op_type::argument_type min1_list = counter.reduce();
+  I min1 = min1_list.first;
+  I min2 = pool.value(min_element_list(pool, min1_list.second.first, cmp_deref));
+  pool.free(min1_list.second);
+  return std::make_pair(min1, min2);
+}
+
+template <typename I, typename Compare>
+// requires I is a ForwardIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+std::pair<I, I> min_element1_2_stable(I first, I last, Compare cmp) {
+  list_pool<I, min_element1_2_index> pool;
+  pool.reserve(256);
+  return min_element1_2_stable(first, last, cmp, pool);
+}
+
+/****************** stable case algorithm indexed ****************************/
+
+
+template <typename Compare>
+class compare_dereference_first
+{
+private:
+  Compare cmp;
+public:
+  compare_dereference_first(const Compare& cmp) : cmp(cmp) {}
+  template <typename I>
+  bool operator() (const I& x, const I& y) {
+    return cmp(*(x.first), *(y.first));
+  }
+};
+
+template <typename Compare>
+class compare_dereference_stable
+{
+private:
+  Compare cmp;
+public:
+  compare_dereference_stable(const Compare& cmp) : cmp(cmp) {}
+
+  template <typename Pair>
+  bool operator() (const Pair& x, const Pair& y) {
+    return (x.second <= y.second) ?
+      !cmp(*(y.first), *(x.first)) :
+      cmp(*(x.first), *(y.first));
+  }
+};
+
+
+template <typename I, typename Compare>
+// requires I is a ForwardIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+// and pool is scratch space, as for min_element1_2
+std::pair<I, I> min_element1_2_stable_indexed(
+  I first, I last, Compare cmp,
+  list_pool<std::pair<I, typename std::iterator_traits<I>::difference_type>,
+            min_element1_2_index>& pool) {
+  if (first == last || successor(first) == last) {
+    return std::make_pair(first, last);
+  }
+
+  typedef typename std::iterator_traits<I>::difference_type diff_t;
+  typedef std::pair<I, diff_t> pair_type;
+  typedef op_min1_2<pair_type, min_element1_2_index, compare_dereference_first<Compare> > op_type;
+ 
+  compare_dereference_first<Compare> cmp_deref(cmp);
+  compare_dereference_stable<Compare> cmp_deref_stable(cmp);
+  op_type op(cmp_deref, pool);
+  diff_t n(0);
+  fixed_binary_counter<op_type> counter(op, std::make_pair(pair_type(last, n), pool.end()));
+
+  while (first != last) counter.add(std::make_pair(pair_type(first++, n++), pool.end()));
+  typename op_type::argument_type min1_list = counter.reduce();
+  I min1 = min1_list.first.first;
+  I min2 = pool.value(min_element_list(pool, min1_list.second, cmp_deref_stable)).first;
+  free_list(pool, min1_list.second);
+  return std::make_pair(min1, min2);
+}
+
+template <typename I, typename Compare>
+// requires I is a ForwardIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+std::pair<I, I> min_element1_2_stable_indexed(I first, I last, Compare cmp) {
+  typedef std::pair<I, typename std::iterator_traits<I>::difference_type> pair_type;
+  list_pool<pair_type, min_element1_2_index> pool;
+  pool.reserve(256);
+  return min_element1_2_stable_indexed(first, last, cmp, pool);
+}
+
+//********************** practical algorithm
+
+template <typename T, typename Compare>
+// Compare is a StrictWeakOrdering on T
+inline
+void insert_2(T& first, T& second, const T& candidate, Compare cmp) {
+  if (cmp(candidate, second)) {
+    if (cmp(candidate, first)) {
+      second = first;
+      first = candidate;
+    } else {
+      second = candidate;
+    }
+  }
+}
+
+template <typename I, typename Compare>
+// requires I is a ForwardIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+std::pair<I, I> min_element1_2_practical(I first, I last, Compare cmp) {
+  if (first == last || successor(first) == last) {
+    return std::make_pair(first, last);
+  }
+
+  compare_dereference<Compare> cmp_deref(cmp);
+
+  I first_place = first++;
+  I second_place = first++;
+  if (cmp_deref(second_place, first_place)) std::swap(first_place, second_place);
+
+  while (first != last) insert_2(first_place, second_place, first++, cmp_deref);
+  return std::make_pair(first_place, second_place);
+}
+
+//********************** parallel practical algorithm
+
+template <typename I, typename Compare>
+// requires I is a ForwardIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+// min_element1_2_practical on a block; second is last for a single element
+struct min_element1_2_practical_block
+{
+  typedef std::pair<I, I> result_type;
+  I last;
+  Compare cmp;
+  min_element1_2_practical_block(I last, const Compare& cmp) : last(last), cmp(cmp) {}
+
+  template <typename N>
+  result_type operator()(I first, N n) {
+    I block_last = first;
+    std::advance(block_last, n);
+    result_type result = min_element1_2_practical(first, block_last, cmp);
+    if (result.second == block_last) result.second = last;
+    return result;
+  }
+};
+
+template <typename I, typename Compare>
+// combines the first two of adjacent blocks, x before y, keeping the
+// earlier of equal elements
+class op_min1_2_stable_pairs
+{
+private:
+  Compare cmp;
+  I last;
+public:
+  typedef std::pair<I, I> argument_type;
+  op_min1_2_stable_pairs(const Compare& cmp, I last) : cmp(cmp), last(last) {}
+  argument_type operator()(const argument_type& x,
+			   const argument_type& y) {
+    if (cmp(y.first, x.first)) {
+      if (y.second != last && cmp(y.second, x.first)) return y;
+      return argument_type(y.first, x.first);
+    }
+    if (x.second != last && !cmp(y.first, x.second)) return x;
+    return argument_type(x.first, y.first);
+  }
+};
+
+template <typename I, typename Compare>
+// requires I is a ForwardIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+// same result as min_element1_2_practical and min_element1_2_stable_indexed
+// (the first two positions of a stable sort), with the blocks scanned by threads
+std::pair<I, I> min_element1_2_practical_parallel(I first, I last, Compare cmp, unsigned threads) {
+  if (first == last || successor(first) == last) {
+    return std::make_pair(first, last);
+  }
+  typedef std::pair<I, I> result_type;
+  return reduce_balanced_parallel(first, std::size_t(std::distance(first, last)),
+				  min_element1_2_practical_block<I, Compare>(last, cmp),
+				  op_min1_2_stable_pairs<I, compare_dereference<Compare> >(
+				    compare_dereference<Compare>(cmp), last),
+				  result_type(last, last), threads);
+}
+
+//********************** vectorized practical algorithm
+
+// min_element1_2_practical(first, last, std::less<T>()) for arrays of
+// arithmetic T. The practical algorithm returns the first two positions of
+// a stable sort, i.e. the two smallest (value, index) pairs, so each lane
+// can keep its own smallest and second smallest with their indices (a lane
+// sees its elements in index order, so strict comparisons keep the earlier
+// of equal values) and the lanes are merged on (value, index) at the end.
+// Values must not be NaN.
+
+template <typename T>
+// requires T is arithmetic
+std::pair<const T*, const T*>
+min_element1_2_vector(const T* first, const T* last) {
+  return min_element1_2_practical(first, last, std::less<T>());
+}
+
+#if defined(__AVX2__)
+
+struct simd_int32
+{
+  typedef int value_type;
+  typedef int32_t index_type;
+  typedef __m256i vector;
+  static const int lanes = 8;
+  static vector load(const value_type* p) { return _mm256_loadu_si256((const __m256i*)p); }
+  static void store(value_type* p, vector x) { _mm256_storeu_si256((__m256i*)p, x); }
+  static __m256i less(vector x, vector y) { return _mm256_cmpgt_epi32(y, x); }
+  static vector select(vector x, vector y, __m256i mask) { return _mm256_blendv_epi8(x, y, mask); }
+  static vector min(vector x, vector y) { return _mm256_min_epi32(x, y); }
+  static vector max(vector x, vector y) { return _mm256_max_epi32(x, y); }
+  static __m256i iota() { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+  static __m256i add_index(__m256i x, __m256i y) { return _mm256_add_epi32(x, y); }
+  static __m256i broadcast_index(index_type i) { return _mm256_set1_epi32(i); }
+};
+
+struct simd_float
+{
+  typedef float value_type;
+  typedef int32_t index_type;
+  typedef __m256 vector;
+  static const int lanes = 8;
+  static vector load(const value_type* p) { return _mm256_loadu_ps(p); }
+  static void store(value_type* p, vector x) { _mm256_storeu_ps(p, x); }
+  static __m256i less(vector x, vector y) { return _mm256_castps_si256(_mm256_cmp_ps(x, y, _CMP_LT_OQ)); }
+  static vector select(vector x, vector y, __m256i mask) {
+    return _mm256_blendv_ps(x, y, _mm256_castsi256_ps(mask));
+  }
+  static vector min(vector x, vector y) { return _mm256_min_ps(x, y); }
+  static vector max(vector x, vector y) { return _mm256_max_ps(x, y); }
+  static __m256i iota() { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+  static __m256i add_index(__m256i x, __m256i y) { return _mm256_add_epi32(x, y); }
+  static __m256i broadcast_index(index_type i) { return _mm256_set1_epi32(i); }
+};
+
+struct simd_double
+{
+  typedef double value_type;
+  typedef int64_t index_type;
+  typedef __m256d vector;
+  static const int lanes = 4;
+  static vector load(const value_type* p) { return _mm256_loadu_pd(p); }
+  static void store(value_type* p, vector x) { _mm256_storeu_pd(p, x); }
+  static __m256i less(vector x, vector y) { return _mm256_castpd_si256(_mm256_cmp_pd(x, y, _CMP_LT_OQ)); }
+  static vector select(vector x, vector y, __m256i mask) {
+    return _mm256_blendv_pd(x, y, _mm256_castsi256_pd(mask));
+  }
+  static vector min(vector x, vector y) { return _mm256_min_pd(x, y); }
+  static vector max(vector x, vector y) { return _mm256_max_pd(x, y); }
+  static __m256i iota() { return _mm256_setr_epi64x(0, 1, 2, 3); }
+  static __m256i add_index(__m256i x, __m256i y) { return _mm256_add_epi64(x, y); }
+  static __m256i broadcast_index(index_type i) { return _mm256_set1_epi64x(i); }
+};
+
+template <typename S>
+// requires S is one of the simd_ descriptions above
+struct min_1_2_lanes
+{
+  typedef typename S::value_type T;
+  typedef typename S::index_type N;
+  typedef typename S::vector V;
+
+  V min1, min2;
+  __m256i index1, index2;
+
+  // starts each lane with two consecutive blocks
+  void start(const T* p, __m256i index) {
+    __m256i next = S::add_index(index, S::broadcast_index(S::lanes));
+    V x0 = S::load(p);
+    V x1 = S::load(p + S::lanes);
+    __m256i swap = S::less(x1, x0);
+    min1 = S::select(x0, x1, swap);
+    min2 = S::select(x1, x0, swap);
+    index1 = _mm256_blendv_epi8(index, next, swap);
+    index2 = _mm256_blendv_epi8(next, index, swap);
+  }
+
+  // insert_2 in every lane: values with min and max, indices with blends
+  void insert(const T* p, __m256i index) {
+    V x = S::load(p);
+    __m256i below2 = S::less(x, min2);
+    __m256i below1 = S::less(x, min1);
+    index2 = _mm256_blendv_epi8(_mm256_blendv_epi8(index2, index, below2), index1, below1);
+    index1 = _mm256_blendv_epi8(index1, index, below1);
+    min2 = S::min(min2, S::max(min1, x));
+    min1 = S::min(min1, x);
+  }
+
+  // the two smallest of lane i, in order, as (value, index)
+  void lane(int i, std::pair<T, N>& first_place, std::pair<T, N>& second_place) const {
+    T values1[S::lanes], values2[S::lanes];
+    N indices1[S::lanes], indices2[S::lanes];
+    S::store(values1, min1);
+    S::store(values2, min2);
+    _mm256_storeu_si256((__m256i*)indices1, index1);
+    _mm256_storeu_si256((__m256i*)indices2, index2);
+    first_place = std::pair<T, N>(values1[i], indices1[i]);
+    second_place = std::pair<T, N>(values2[i], indices2[i]);
+  }
+
+  // inserts the two smallest of the lanes from first_lane on
+  template <typename Compare>
+  void merge_into(std::pair<T, N>& first_place, std::pair<T, N>& second_place, Compare cmp,
+                  int first_lane = 0) const {
+    T values1[S::lanes], values2[S::lanes];
+    N indices1[S::lanes], indices2[S::lanes];
+    S::store(values1, min1);
+    S::store(values2, min2);
+    _mm256_storeu_si256((__m256i*)indices1, index1);
+    _mm256_storeu_si256((__m256i*)indices2, index2);
+    for (int i = first_lane; i < S::lanes; ++i) {
+      insert_2(first_place, second_place, std::pair<T, N>(values1[i], indices1[i]), cmp);
+      insert_2(first_place, second_place, std::pair<T, N>(values2[i], indices2[i]), cmp);
+    }
+  }
+};
+
+template <typename S>
+// requires S is one of the simd_ descriptions above
+std::pair<const typename S::value_type*, const typename S::value_type*>
+min_element1_2_avx2(const typename S::value_type* first, const typename S::value_type* last) {
+  typedef typename S::value_type T;
+  typedef typename S::index_type N;
+  const int lanes = S::lanes;
+  std::ptrdiff_t n = last - first;
+  if (n < 4 * lanes || uint64_t(n) > uint64_t(std::numeric_limits<N>::max())) {
+    return min_element1_2_practical(first, last, std::less<T>());
+  }
+
+  // two independent sets of lanes, taking alternate blocks, so that the
+  // comparisons of one block do not wait for those of the previous one
+  min_1_2_lanes<S> a, b;
+  __m256i index = S::iota();
+  const __m256i step = S::broadcast_index(lanes);
+  a.start(first, index);
+  index = S::add_index(index, S::add_index(step, step));
+  b.start(first + 2 * lanes, index);
+  index = S::add_index(index, S::add_index(step, step));
+  const T* p = first + 4 * lanes;
+  for (; last - p >= 2 * lanes; p += 2 * lanes) {
+    a.insert(p, index);
+    index = S::add_index(index, step);
+    b.insert(p + lanes, index);
+    index = S::add_index(index, step);
+  }
+  if (last - p >= lanes) {
+    a.insert(p, index);
+    p += lanes;
+  }
+
+  // merge the lanes on (value, index), starting from the first lane: no
+  // sentinel value is safe, since infinities and NaNs beat none
+  typedef std::pair<T, N> indexed;
+  indexed first_place, second_place;
+  a.lane(0, first_place, second_place);
+  a.merge_into(first_place, second_place, std::less<indexed>(), 1);
+  b.merge_into(first_place, second_place, std::less<indexed>());
+
+  // the tail comes after every lane, so only a strictly smaller value moves
+  const T* result1 = first + first_place.second;
+  const T* result2 = first + second_place.second;
+  compare_dereference<std::less<T> > cmp_deref((std::less<T>()));
+  while (p != last) insert_2(result1, result2, p++, cmp_deref);
+  return std::make_pair(result1, result2);
+}
+
+inline
+std::pair<const int*, const int*> min_element1_2_vector(const int* first, const int* last) {
+  return min_element1_2_avx2<simd_int32>(first, last);
+}
+
+inline
+std::pair<const float*, const float*> min_element1_2_vector(const float* first, const float* last) {
+  return min_element1_2_avx2<simd_float>(first, last);
+}
+
+inline
+std::pair<const double*, const double*> min_element1_2_vector(const double* first, const double* last) {
+  return min_element1_2_avx2<simd_double>(first, last);
+}
+
+#endif
+
+template <typename T>
+// requires T is arithmetic
+// returns: the same as min_element1_2_practical(first, last, std::less<T>())
+std::pair<T*, T*> min_element1_2_practical_simd(T* first, T* last) {
+  std::pair<const T*, const T*> result = min_element1_2_vector((const T*)first, (const T*)last);
+  return std::make_pair(first + (result.first - first), first + (result.second - first));
+}
+
+#endif
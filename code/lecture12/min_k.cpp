@@ -0,0 +1,62 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <cstdlib>
+#include <vector>
+#include "algorithm.h"
+#include "timer.h"
+#include "min_k_elements.h"
+
+// k smallest of n ints: tournament selection against partial_sort and
+// nth_element followed by sorting the first k
+
+int main() {
+  const size_t n(1000 * 1000);
+  const size_t ks[] = {1, 2, 10, 100, 300, 1000};
+  std::vector<int> data(n);
+  random_iota(data.begin(), data.end());
+
+  std::cout << std::setw(6) << "k"
+            << std::setw(14) << "tournament"
+            << std::setw(14) << "stable"
+            << std::setw(14) << "partial_sort"
+            << std::setw(14) << "nth_element" << "   (ns per element)" << std::endl;
+  for (size_t i = 0; i < sizeof(ks) / sizeof(ks[0]); ++i) {
+    size_t k = ks[i];
+    timer t;
+    int checksum = 0;
+
+    t.start();
+    std::vector<std::vector<int>::iterator> result =
+      min_k_elements(data.begin(), data.end(), k, std::less<int>());
+    double tournament = t.stop();
+    checksum += *result.back();
+
+    t.start();
+    result = min_k_elements_stable(data.begin(), data.end(), k, std::less<int>());
+    double stable = t.stop();
+    checksum += *result.back();
+
+    std::vector<int> copy(data);
+    t.start();
+    std::partial_sort(copy.begin(), copy.begin() + k, copy.end());
+    double partial = t.stop();
+    checksum += copy[k - 1];
+
+    copy = data;
+    t.start();
+    std::nth_element(copy.begin(), copy.begin() + (k - 1), copy.end());
+    std::sort(copy.begin(), copy.begin() + k);
+    double nth = t.stop();
+    checksum += copy[k - 1];
+
+    std::cout << std::setw(6) << k
+              << std::setw(14) << tournament / double(n)
+              << std::setw(14) << stable / double(n)
+              << std::setw(14) << partial / double(n)
+              << std::setw(14) << nth / double(n)
+              << (checksum == 4 * int(k - 1) ? "" : " *** WRONG ***") << std::endl;
+  }
+}
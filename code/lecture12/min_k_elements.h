@@ -0,0 +1,207 @@
+#ifndef MIN_K_ELEMENTS_H
+#define MIN_K_ELEMENTS_H
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+#include <stdint.h>
+#include "binary_counter.h"
+#include "list_pool.h"
+#include "min_element1_2.h"
+
+// The tournament of min_element1_2 generalized to the k smallest.
+// Every player keeps a list of the players it beat, not just the winner,
+// so the tournament leaves a tree: the winner, its losers, their losers
+// and so on. The next smallest is among the direct losers of the winner,
+// so each extraction replays only that list, with a binary counter, and
+// the new winner inherits the rest of the tree.
+// Only the k - 1 smallest losers of a player can be among the k smallest
+// (any other has k smaller or equal elements in front of it), and only
+// k - 2 of a player that lost, so the lists are cut to those and the
+// trees of the players cut are freed: for small k the pool stays small.
+
+template <typename T, typename N>
+// N is integral
+struct min_k_tree
+{
+  T value;
+  N losers; // list of the trees of the players it beat
+  N size;   // the length of losers
+  min_k_tree() {}
+  min_k_tree(const T& value, N losers, N size) : value(value), losers(losers), size(size) {}
+};
+
+template <typename T, typename N, typename Compare>
+class op_min_k
+{
+public:
+  typedef N list_type;
+  typedef min_k_tree<T, N> argument_type;
+
+private:
+  Compare cmp;
+  list_pool<argument_type, N>* p;
+  std::size_t k;
+
+  // frees the node of x and the whole tree below it
+  void free_tree(list_type x) {
+    list_type losers = p->value(x).losers;
+    while (!p->is_end(losers)) {
+      list_type next = p->next(losers);
+      free_tree(losers);
+      losers = next;
+    }
+    p->free(x);
+  }
+
+  // returns: the node before the loser of x with the largest value, or
+  // end() if it is the first one
+  list_type before_largest(const argument_type& x) {
+    list_type previous = p->end();
+    list_type largest = x.losers;
+    for (list_type i = x.losers; !p->is_end(p->next(i)); i = p->next(i)) {
+      if (cmp(p->value(largest).value, p->value(p->next(i)).value)) {
+        previous = i;
+        largest = p->next(i);
+      }
+    }
+    return previous;
+  }
+
+  // frees the largest losers of x until it has at most m
+  void cut(argument_type& x, std::size_t m) {
+    while (std::size_t(x.size) > m) {
+      list_type previous = before_largest(x);
+      list_type largest = p->is_end(previous) ? x.losers : p->next(previous);
+      if (p->is_end(previous)) x.losers = p->next(largest);
+      else p->next(previous) = p->next(largest);
+      p->next(largest) = p->end();
+      free_tree(largest);
+      --x.size;
+    }
+  }
+
+  // adds y to the losers of x, keeping the k - 1 smallest
+  argument_type beat(argument_type x, argument_type y) {
+    if (k < 2) {
+      cut(y, 0);
+      return x;
+    }
+    cut(y, k - 2);
+    if (std::size_t(x.size) < k - 1) {
+      x.losers = p->allocate(y, x.losers);
+      ++x.size;
+      return x;
+    }
+    list_type previous = before_largest(x);
+    list_type largest = p->is_end(previous) ? x.losers : p->next(previous);
+    if (!cmp(y.value, p->value(largest).value)) {
+      cut(y, 0);
+      return x;
+    }
+    list_type tail = p->next(largest);
+    p->next(largest) = p->end();
+    free_tree(largest);
+    list_type node = p->allocate(y, tail);
+    if (p->is_end(previous)) x.losers = node;
+    else p->next(previous) = node;
+    return x;
+  }
+
+public:
+  op_min_k(const Compare& cmp, list_pool<argument_type, N>& pool, std::size_t k) :
+    cmp(cmp), p(&pool), k(k) {}
+
+  argument_type operator()(const argument_type& x, const argument_type& y) {
+    if (!cmp(y.value, x.value)) return beat(x, y);
+    return beat(y, x);
+  }
+};
+
+template <typename T, typename N, typename Compare>
+// requires Compare is a StrictWeakOrdering on T
+// extracts up to k successive minima from the tree left by the tournament;
+// none is a value of T for the empty counter
+std::vector<T> extract_min_k(min_k_tree<T, N> winner, std::size_t k, const T& none,
+                             op_min_k<T, N, Compare>& op,
+                             list_pool<min_k_tree<T, N>, N>& pool) {
+  std::vector<T> result;
+  result.reserve(k);
+  while (result.size() < k) {
+    result.push_back(winner.value);
+    if (pool.is_end(winner.losers)) break;
+    N x = winner.losers;
+    fixed_binary_counter<op_min_k<T, N, Compare> > replay(op, min_k_tree<T, N>(none, pool.end(), N(0)));
+    while (!pool.is_end(x)) {
+      replay.add(pool.value(x));
+      x = pool.free(x);
+    }
+    winner = replay.reduce();
+  }
+  return result;
+}
+
+// one index per element, so ranges up to 2^32 - 1 elements
+typedef uint32_t min_k_index;
+
+template <typename I, typename Compare>
+// requires I is a ForwardIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+// returns: iterators to the k smallest elements, ascending
+std::vector<I> min_k_elements(I first, I last, std::size_t k, Compare cmp) {
+  if (first == last || k == 0) return std::vector<I>();
+  typedef op_min_k<I, min_k_index, compare_dereference<Compare> > op_type;
+  typedef typename op_type::argument_type tree;
+
+  list_pool<tree, min_k_index> pool;
+  pool.reserve(std::distance(first, last));
+  op_type op(compare_dereference<Compare>(cmp), pool, k);
+  fixed_binary_counter<op_type> counter(op, tree(last, pool.end(), 0));
+  while (first != last) counter.add(tree(first++, pool.end(), 0));
+  return extract_min_k(counter.reduce(), k, last, op, pool);
+}
+
+/****************** stable algorithm ****************************/
+
+template <typename Compare>
+class compare_dereference_indexed
+{
+private:
+  Compare cmp;
+public:
+  compare_dereference_indexed(const Compare& cmp) : cmp(cmp) {}
+
+  // the value, then the position: a total order
+  template <typename Pair>
+  bool operator() (const Pair& x, const Pair& y) const {
+    if (cmp(*(x.first), *(y.first))) return true;
+    if (cmp(*(y.first), *(x.first))) return false;
+    return x.second < y.second;
+  }
+};
+
+template <typename I, typename Compare>
+// requires I is a ForwardIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+// returns: iterators to the k smallest elements, ascending, with equal
+// elements in their original order
+std::vector<I> min_k_elements_stable(I first, I last, std::size_t k, Compare cmp) {
+  std::vector<I> result;
+  if (first == last || k == 0) return result;
+  typedef std::pair<I, std::size_t> indexed;
+  typedef op_min_k<indexed, min_k_index, compare_dereference_indexed<Compare> > op_type;
+  typedef typename op_type::argument_type tree;
+
+  list_pool<tree, min_k_index> pool;
+  pool.reserve(std::distance(first, last));
+  op_type op(compare_dereference_indexed<Compare>(cmp), pool, k);
+  std::size_t n(0);
+  fixed_binary_counter<op_type> counter(op, tree(indexed(last, n), pool.end(), 0));
+  while (first != last) counter.add(tree(indexed(first++, n++), pool.end(), 0));
+  std::vector<indexed> min_k = extract_min_k(counter.reduce(), k, indexed(last, n), op, pool);
+  result.reserve(min_k.size());
+  for (std::size_t i = 0; i < min_k.size(); ++i) result.push_back(min_k[i].first);
+  return result;
+}
+
+#endif
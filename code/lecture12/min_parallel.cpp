@@ -0,0 +1,48 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include "algorithm.h"
+#include "min_element1_2.h"
+
+// scaling of the parallel min_element1_2 variants from 1 thread to all
+// cores; wall clock time, since the timer measures processor time
+
+template <typename I>
+double time_min_1_2(std::pair<I, I> (*algorithm)(I, I, std::less<int>, unsigned),
+                    I first, I last, unsigned threads, const std::pair<I, I>& expected) {
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  std::pair<I, I> result = algorithm(first, last, std::less<int>(), threads);
+  std::chrono::duration<double, std::nano> time = std::chrono::steady_clock::now() - start;
+  if (result != expected) std::cout << " *** WRONG ***";
+  return time.count() / double(last - first);
+}
+
+int main() {
+  const size_t n(64 * 1000 * 1000);
+  std::vector<int> values(n);
+  random_iota(values.begin(), values.end());
+  typedef std::vector<int>::iterator I;
+  I first = values.begin();
+  I last = values.end();
+  std::pair<I, I> expected = min_element1_2_practical(first, last, std::less<int>());
+  std::pair<I, I> expected_tournament = min_element1_2(first, last, std::less<int>());
+
+  unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+  std::cout << n << " ints, ns per element" << std::endl;
+  std::cout << std::setw(8) << "threads" << std::setw(12) << "practical" << std::setw(12) << "tournament"
+            << std::endl;
+  for (unsigned threads = 1; threads <= cores;
+       threads = threads == cores ? cores + 1 : std::min(2 * threads, cores)) {
+    std::cout << std::setw(8) << threads;
+    std::cout << std::setw(12) << time_min_1_2(min_element1_2_practical_parallel<I, std::less<int> >,
+                                               first, last, threads, expected);
+    std::cout << std::setw(12) << time_min_1_2(min_element1_2_parallel<I, std::less<int> >,
+                                               first, last, threads, expected_tournament);
+    std::cout << std::endl;
+  }
+}
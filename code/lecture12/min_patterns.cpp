@@ -0,0 +1,77 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <vector>
+#include "algorithm.h"
+#include "timer.h"
+#include "branch_misses.h"
+#include "min_element1_2.h"
+
+// time and branch misses per element of the min_element1_2 variants on
+// sorted, reverse sorted, hill, valley, sawtooth and random input: the
+// tournament kernels compare in a fixed pattern, while insert_2 in
+// min_element1_2_practical takes its rare branch on every new candidate,
+// which is every element of a descending input. Build with -mavx2 for the
+// vectorized practical algorithm.
+
+template <typename T>
+std::pair<T*, T*> practical_simd(T* first, T* last, std::less<T>) {
+  return min_element1_2_practical_simd(first, last);
+}
+
+template <typename T>
+void print_pattern_times(size_t n) {
+  typedef typename std::vector<T>::iterator I;
+  typedef std::pair<T*, T*> (*kernel)(T*, T*, std::less<T>);
+  void (*generators[])(I, I) = {
+    iota<I>, reverse_iota<I>, hill<I>, valley<I>, sawtooth<I>, random_iota<I>
+  };
+  const char* generator_names[] = {"iota", "reverse_iota", "hill", "valley", "sawtooth", "random_iota"};
+  kernel kernels[] = {
+    min_element1_2<T*>, min_element1_2_stable<T*>, min_element1_2_practical<T*>, practical_simd<T>
+  };
+  const char* names[] = {"tournament", "stable", "practical", "simd"};
+  const size_t number_of_kernels = sizeof(kernels) / sizeof(kernels[0]);
+  // repeat small arrays so that each measurement covers 16M elements
+  size_t repeat = std::max(size_t(1), (size_t(1) << 24) / n);
+  branch_misses misses;
+
+  std::cout << n << " elements: ns per element"
+            << (misses.available() ? " / branch misses per element" : " (no branch miss counter)")
+            << std::endl << std::setw(14) << "";
+  for (size_t k = 0; k < number_of_kernels; ++k) std::cout << std::setw(14) << names[k];
+  std::cout << std::endl;
+
+  std::vector<T> data(n);
+  for (size_t g = 0; g < sizeof(generators) / sizeof(generators[0]); ++g) {
+    generators[g](data.begin(), data.end());
+    T* first = &data[0];
+    T* last = first + n;
+    std::pair<T*, T*> expected = min_element1_2_practical(first, last, std::less<T>());
+    std::cout << std::setw(14) << generator_names[g];
+    for (size_t k = 0; k < number_of_kernels; ++k) {
+      std::pair<T*, T*> result;
+      timer t;
+      t.start();
+      misses.start();
+      for (size_t i = 0; i < repeat; ++i) result = kernels[k](first, last, std::less<T>());
+      double missed = double(misses.stop());
+      double time = t.stop();
+      std::cout << std::setw(misses.available() ? 7 : 14) << std::fixed << std::setprecision(2)
+                << time / double(n * repeat);
+      if (misses.available()) std::cout << std::setw(7) << missed / double(n * repeat);
+      // the tournament is not stable: on ties only the values must agree
+      if (*result.first != *expected.first || *result.second != *expected.second) {
+        std::cout << " *** WRONG ***";
+      }
+    }
+    std::cout << std::endl;
+  }
+}
+
+int main() {
+  print_pattern_times<int>(64 * 1024);
+  print_pattern_times<double>(64 * 1024);
+}
@@ -0,0 +1,98 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include "algorithm.h"
+#include "timer.h"
+#include "min_element1_2.h"
+
+// time per element of the min_element1_2 variants on arrays of ints and
+// doubles; build with -mavx2 for the vectorized practical algorithm
+
+template <typename T>
+void time_min_1_2(std::pair<T*, T*> (*algorithm)(T*, T*, std::less<T>),
+                  T* first, T* last, const std::pair<T*, T*>& expected, const char* name) {
+  // repeat small arrays so that each measurement covers 16M elements
+  size_t n = last - first;
+  size_t repeat = std::max(size_t(1), (size_t(1) << 24) / n);
+  std::pair<T*, T*> result;
+  timer t;
+  t.start();
+  for (size_t i = 0; i < repeat; ++i) result = algorithm(first, last, std::less<T>());
+  double time = t.stop();
+  std::cout << std::setw(40) << name << std::setw(12) << time / double(n * repeat)
+            << (result == expected ? "" : " *** WRONG ***") << std::endl;
+}
+
+template <typename T>
+std::pair<T*, T*> practical_simd(T* first, T* last, std::less<T>) {
+  return min_element1_2_practical_simd(first, last);
+}
+
+template <typename T>
+void time_all(size_t n, const char* type_name) {
+  std::vector<int> values(n);
+  random_iota(values.begin(), values.end());
+  // every value twice, so ties are resolved on every run
+  std::vector<T> data(2 * n);
+  for (size_t i = 0; i < n; ++i) data[i] = data[n + i] = T(values[i]);
+  T* first = &data[0];
+  T* last = first + data.size();
+  std::pair<T*, T*> expected = min_element1_2_practical(first, last, std::less<T>());
+
+  std::cout << type_name << ", " << data.size() << " elements, ns per element" << std::endl;
+  time_min_1_2<T>(min_element1_2<T*>, first, last, expected, "min_element1_2");
+  time_min_1_2<T>(min_element1_2_stable_random_access<T*>, first, last, expected,
+                  "min_element1_2_stable_random_access");
+  time_min_1_2<T>(min_element1_2_stable<T*>, first, last, expected, "min_element1_2_stable");
+  time_min_1_2<T>(min_element1_2_stable_indexed<T*>, first, last, expected, "min_element1_2_stable_indexed");
+  time_min_1_2<T>(min_element1_2_practical<T*>, first, last, expected, "min_element1_2_practical");
+  time_min_1_2<T>(practical_simd<T>, first, last, expected, "min_element1_2_practical_simd");
+}
+
+// infinities, the largest value and NaNs, where no sentinel works: the
+// results must be those of min_element1_2_practical, and with NaNs (not a
+// strict weak ordering) at least two distinct elements of the range
+template <typename T>
+bool check_special_values(size_t n) {
+  const T inf = std::numeric_limits<T>::infinity();
+  const T nan = std::numeric_limits<T>::quiet_NaN();
+  const T big = std::numeric_limits<T>::max();
+  bool ok = true;
+  for (int pattern = 0; pattern < 5; ++pattern) {
+    std::vector<T> data(n, pattern == 2 ? big : inf);
+    if (pattern == 1) data[n / 2] = T(1);
+    if (pattern == 3) data[n - 1] = -inf;
+    if (pattern == 4) {
+      for (size_t i = 0; i < n; i += 3) data[i] = nan;
+      data[n / 3] = T(2);
+    }
+    T* first = &data[0];
+    T* last = first + n;
+    std::pair<T*, T*> result = min_element1_2_practical_simd(first, last);
+    bool in_range = first <= result.first && result.first < last &&
+                    first <= result.second && result.second < last &&
+                    result.first != result.second;
+    ok = ok && in_range;
+    if (pattern != 4) ok = ok && result == min_element1_2_practical(first, last, std::less<T>());
+  }
+  return ok;
+}
+
+int main() {
+  bool special = true;
+  for (size_t n = 2; n <= 200; n += 13) {
+    special = special && check_special_values<float>(n) && check_special_values<double>(n);
+  }
+  std::cout << "infinities and NaNs: " << (special ? "ok" : "*** WRONG ***") << std::endl;
+
+  // in L2, and far out of cache
+  const size_t sizes[] = {8 * 1024, 4 * 1000 * 1000};
+  for (size_t i = 0; i < 2; ++i) {
+    time_all<int>(sizes[i], "int");
+    time_all<double>(sizes[i], "double");
+  }
+}
@@ -0,0 +1,92 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <vector>
+#include "algorithm.h"
+#include "timer.h"
+#include "min_element1_2.h"
+
+// min_element1_2 on many small groups: a pool per call against one
+// scratch pool reused by every call
+
+typedef std::vector<int>::iterator I;
+typedef std::ptrdiff_t D;
+
+const size_t total(1 << 22);
+
+template <typename Algorithm>
+double time_groups(Algorithm algorithm, std::vector<int>& data, size_t n) {
+  timer t;
+  int checksum = 0;
+  t.start();
+  for (I first = data.begin(); data.end() - first >= D(n); first += n) {
+    checksum += *algorithm(first, first + n).second;
+  }
+  double time = t.stop();
+  if (checksum == 1) std::cout << checksum;
+  return time / double(total / n);
+}
+
+struct fresh_pool
+{
+  std::pair<I, I> operator()(I first, I last) const {
+    return min_element1_2(first, last, std::less<int>());
+  }
+};
+
+struct scratch_pool
+{
+  list_pool<I, min_element1_2_index>* pool;
+  std::pair<I, I> operator()(I first, I last) const {
+    return min_element1_2(first, last, std::less<int>(), *pool);
+  }
+};
+
+struct fresh_pool_stable
+{
+  std::pair<I, I> operator()(I first, I last) const {
+    return min_element1_2_stable_indexed(first, last, std::less<int>());
+  }
+};
+
+struct scratch_pool_stable
+{
+  list_pool<std::pair<I, D>, min_element1_2_index>* pool;
+  std::pair<I, I> operator()(I first, I last) const {
+    return min_element1_2_stable_indexed(first, last, std::less<int>(), *pool);
+  }
+};
+
+struct practical
+{
+  std::pair<I, I> operator()(I first, I last) const {
+    return min_element1_2_practical(first, last, std::less<int>());
+  }
+};
+
+int main() {
+  std::vector<int> data(total);
+  random_iota(data.begin(), data.end());
+  list_pool<I, min_element1_2_index> pool;
+  list_pool<std::pair<I, D>, min_element1_2_index> pool_stable;
+  scratch_pool scratch = {&pool};
+  scratch_pool_stable scratch_stable = {&pool_stable};
+
+  const size_t sizes[] = {8, 16, 32, 50, 64, 128, 256, 1024};
+  std::cout << "ns per call" << std::endl;
+  std::cout << std::setw(6) << "n" << std::setw(10) << "fresh" << std::setw(10) << "scratch"
+            << std::setw(16) << "stable fresh" << std::setw(16) << "stable scratch"
+            << std::setw(12) << "practical" << std::endl;
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+    size_t n = sizes[i];
+    std::cout << std::setw(6) << n
+              << std::setw(10) << time_groups(fresh_pool(), data, n)
+              << std::setw(10) << time_groups(scratch, data, n)
+              << std::setw(16) << time_groups(fresh_pool_stable(), data, n)
+              << std::setw(16) << time_groups(scratch_stable, data, n)
+              << std::setw(12) << time_groups(practical(), data, n) << std::endl;
+  }
+  std::cout << "scratch pool nodes: " << pool.size() << ", " << pool_stable.size() << std::endl;
+}
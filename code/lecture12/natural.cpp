@@ -0,0 +1,61 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <vector>
+#include "algorithm.h"
+#include "timer.h"
+#include "list_pool.h"
+#include "list_algorithm.h"
+
+// mergesort_linked against mergesort_linked_natural on lists generated
+// from each input pattern: ns and comparisons per node
+
+struct counting_less
+{
+  size_t* count;
+  bool operator()(int x, int y) const {
+    ++*count;
+    return x < y;
+  }
+};
+
+typedef list_pool<int, uint32_t> pool_type;
+typedef pool_type::iterator I;
+
+void time_sort(I (*sort)(I, I, counting_less), const std::vector<int>& values) {
+  pool_type pool;
+  pool.reserve(values.size());
+  I nil(pool);
+  I list = generate_list(values.begin(), values.end(), nil);
+  size_t comparisons = 0;
+  counting_less cmp = {&comparisons};
+  timer t;
+  t.start();
+  list = sort(list, nil, cmp);
+  double time = t.stop();
+  bool sorted = std::is_sorted(list, nil) && size_t(std::distance(list, nil)) == values.size();
+  std::cout << std::setw(12) << std::fixed << std::setprecision(1) << time / double(values.size())
+            << std::setw(8) << std::setprecision(2) << double(comparisons) / double(values.size())
+            << (sorted ? "" : " *** WRONG ***");
+}
+
+int main() {
+  const size_t n(1000 * 1000);
+  typedef std::vector<int>::iterator V;
+  void (*generators[])(V, V) = {iota<V>, reverse_iota<V>, hill<V>, valley<V>, random_iota<V>};
+  const char* names[] = {"iota", "reverse_iota", "hill", "valley", "random_iota"};
+
+  std::cout << n << " nodes, ns and comparisons per node" << std::endl;
+  std::cout << std::setw(14) << "" << std::setw(20) << "mergesort_linked"
+            << std::setw(20) << "natural" << std::endl;
+  std::vector<int> values(n);
+  for (size_t g = 0; g < sizeof(generators) / sizeof(generators[0]); ++g) {
+    generators[g](values.begin(), values.end());
+    std::cout << std::setw(14) << names[g];
+    time_sort(mergesort_linked<I, counting_less>, values);
+    time_sort(mergesort_linked_natural<I, counting_less>, values);
+    std::cout << std::endl;
+  }
+}
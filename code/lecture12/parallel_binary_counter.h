@@ -0,0 +1,101 @@
+#ifndef PARALLEL_BINARY_COUNTER_H
+#define PARALLEL_BINARY_COUNTER_H
+
+#include <cstddef>
+#include <iterator>
+#include <thread>
+#include <vector>
+#include "binary_counter.h"
+
+// Parallel balanced reduction.
+// The range is cut into blocks of 2^m elements (plus a shorter tail) and
+// each thread reduces whole blocks, each with its own binary counter.
+// A full block ends up as a single value in slot m, so feeding the block
+// values in order into a binary counter gives exactly the slots a serial
+// binary_counter would hold above m, and the tail gives the slots below m.
+// Blocks are only ever combined with their neighbours, older on the left,
+// so the result is the same as the serial one for any associative op,
+// commutative or not (e.g. a stable merge).
+
+template <typename I, typename N, typename T, typename ReduceBlock>
+// requires I is ForwardIterator
+// and N is Integral
+// and ReduceBlock is a function object (I, N) -> T
+struct reduce_blocks_worker
+{
+  ReduceBlock reduce_block;
+  const std::vector<I>* starts;
+  std::vector<T>* results;
+  N block_size;
+  std::size_t first_block;
+  std::size_t last_block;
+
+  reduce_blocks_worker(const ReduceBlock& reduce_block,
+                       const std::vector<I>& starts, std::vector<T>& results,
+                       N block_size, std::size_t first_block, std::size_t last_block) :
+    reduce_block(reduce_block), starts(&starts), results(&results),
+    block_size(block_size), first_block(first_block), last_block(last_block) {}
+
+  void operator()() {
+    for (std::size_t i = first_block; i != last_block; ++i) {
+      (*results)[i] = reduce_block((*starts)[i], block_size);
+    }
+  }
+};
+
+template <typename N>
+// requires N is Integral
+N balanced_block_size(N n, unsigned threads) {
+  // returns: the largest power of two not exceeding max(n / threads, 1)
+  N target = threads > 1 ? n / N(threads) : n;
+  N block(1);
+  while (block <= target / N(2)) block *= N(2);
+  return block;
+}
+
+template <typename I, typename N, typename T, typename ReduceBlock, typename Op>
+// requires I is ForwardIterator
+// and N is Integral
+// and ReduceBlock is a function object (I, N) -> T that reduces a range of
+//     n elements (n a power of two for all but the last block) with a
+//     binary counter; it must be safe to run concurrently on disjoint blocks
+// and Op is BinaryOperation(T) and Op is associative
+T reduce_balanced_parallel(I first, N n, ReduceBlock reduce_block, Op op,
+                           const T& zero, unsigned threads) {
+  if (n == N(0)) return zero;
+  if (threads == 0) threads = 1;
+  N block_size = balanced_block_size(n, threads);
+  std::size_t blocks = std::size_t(n / block_size);
+  N tail_size = n - N(blocks) * block_size;
+
+  // one pass to find where each block starts
+  std::vector<I> starts;
+  starts.reserve(blocks + 1);
+  for (std::size_t i = 0; i <= blocks; ++i) {
+    starts.push_back(first);
+    if (i != blocks) std::advance(first, block_size);
+  }
+
+  std::vector<T> results(blocks, zero);
+  std::vector<std::thread> workers;
+  for (unsigned t = 1; t < threads; ++t) {
+    workers.push_back(std::thread(
+      reduce_blocks_worker<I, N, T, ReduceBlock>(reduce_block, starts, results, block_size,
+                                                 blocks * t / threads, blocks * (t + 1) / threads)));
+  }
+  reduce_blocks_worker<I, N, T, ReduceBlock>(reduce_block, starts, results, block_size,
+                                             0, blocks / threads)();
+  T tail = tail_size == N(0) ? zero : reduce_block(starts[blocks], tail_size);
+  for (std::size_t t = 0; t < workers.size(); ++t) workers[t].join();
+
+  // the tail is already reduced, so it takes the place of all slots below m
+  std::vector<T> counter(1, tail);
+  counter.reserve(64);
+  for (std::size_t i = 0; i < blocks; ++i) {
+    T carry = add_to_counter(counter.begin() + 1, counter.end(), op, zero, results[i]);
+    if (carry != zero) counter.push_back(carry);
+  }
+  return reduce_counter(counter.begin(), counter.end(), op, zero);
+}
+
+#endif
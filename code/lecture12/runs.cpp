@@ -0,0 +1,168 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "algorithm.h"
+#include "timer.h"
+#include "binary_counter.h"
+#include "list_pool.h"
+#include "list_algorithm.h"
+
+// mergesort_linked starts from insertion sorted runs of 16 nodes added at
+// level 4, and add_range reduces blocks of 16 values before they reach the
+// counter. Checks that both build the trees they replace, then times them
+// against one node (or value) at a time.
+
+// records the shape of the tree: the result of add_range must be the
+// result of adding the values one by one
+struct shape_op
+{
+  typedef std::string argument_type;
+  std::string operator()(const std::string& x, const std::string& y) const {
+    return "(" + x + y + ")";
+  }
+};
+
+template <typename Counter>
+std::string reduce_one_by_one(const std::vector<std::string>& values) {
+  Counter counter((shape_op()), std::string());
+  for (size_t i = 0; i < values.size(); ++i) counter.add(values[i]);
+  return counter.reduce();
+}
+
+template <typename Counter>
+std::string reduce_range(const std::vector<std::string>& values) {
+  Counter counter((shape_op()), std::string());
+  // a few single values first, so that the blocks are not aligned
+  size_t head = std::min(values.size(), values.size() % 5);
+  for (size_t i = 0; i < head; ++i) counter.add(values[i]);
+  counter.add_range(values.begin() + head, values.end());
+  return counter.reduce();
+}
+
+bool check_add_range() {
+  bool ok = true;
+  std::vector<std::string> values;
+  for (size_t n = 0; n < 300; ++n) {
+    ok = ok && reduce_range<binary_counter<shape_op> >(values) ==
+               reduce_one_by_one<binary_counter<shape_op> >(values);
+    ok = ok && reduce_range<fixed_binary_counter<shape_op> >(values) ==
+               reduce_one_by_one<fixed_binary_counter<shape_op> >(values);
+    values.push_back(std::string(1, char('a' + n % 26)));
+  }
+  return ok;
+}
+
+typedef std::pair<int, int> keyed;
+
+struct less_key
+{
+  bool operator()(const keyed& x, const keyed& y) const { return x.first < y.first; }
+};
+
+// sorts (key, position) pairs with few distinct keys like std::stable_sort
+bool check_stable() {
+  typedef list_pool<keyed, uint32_t> pool_type;
+  typedef pool_type::iterator I;
+  bool ok = true;
+  for (int n = 0; n < 600; n += 7) {
+    std::vector<keyed> values;
+    for (int i = 0; i < n; ++i) values.push_back(keyed(std::rand() % 5, i));
+    std::vector<keyed> expected(values);
+    std::stable_sort(expected.begin(), expected.end(), less_key());
+    pool_type pool;
+    I nil(pool);
+    I list = mergesort_linked(generate_list(values.begin(), values.end(), nil), nil, less_key());
+    ok = ok && std::vector<keyed>(list, nil) == expected;
+    list = mergesort_linked_nodes_n(generate_list(values.begin(), values.end(), nil), n, nil, less_key());
+    ok = ok && std::vector<keyed>(list, nil) == expected;
+  }
+  return ok;
+}
+
+struct counting_less
+{
+  size_t* count;
+  bool operator()(int x, int y) const {
+    ++*count;
+    return x < y;
+  }
+};
+
+typedef list_pool<int, uint32_t> pool_type;
+typedef pool_type::iterator I;
+
+void time_sort(I (*sort)(I, size_t, I, counting_less), const std::vector<int>& values) {
+  size_t n = values.size();
+  size_t repeat = std::max(size_t(1), (size_t(1) << 22) / n);
+  size_t comparisons = 0;
+  counting_less cmp = {&comparisons};
+  double time = 0;
+  bool sorted = true;
+  for (size_t r = 0; r < repeat; ++r) {
+    pool_type pool;
+    pool.reserve(n);
+    I nil(pool);
+    I list = generate_list(values.begin(), values.end(), nil);
+    timer t;
+    t.start();
+    list = sort(list, n, nil, cmp);
+    time += t.stop();
+    sorted = sorted && std::is_sorted(list, nil) && size_t(std::distance(list, nil)) == n;
+  }
+  std::cout << std::setw(10) << std::fixed << std::setprecision(1) << time / double(n * repeat)
+            << std::setw(8) << std::setprecision(2) << double(comparisons) / double(n * repeat)
+            << (sorted ? "" : " *** WRONG ***");
+}
+
+// a cheap op, so that the time is the counter's own
+struct plus_op
+{
+  typedef uint64_t argument_type;
+  uint64_t operator()(uint64_t x, uint64_t y) const { return x + y; }
+};
+
+void time_add_range(size_t n) {
+  // values from 1: zero is the empty slot
+  std::vector<uint64_t> values(n);
+  for (size_t i = 0; i < n; ++i) values[i] = i + 1;
+  timer t;
+  t.start();
+  fixed_binary_counter<plus_op> one_by_one((plus_op()), 0);
+  for (size_t i = 0; i < n; ++i) one_by_one.add(values[i]);
+  uint64_t x = one_by_one.reduce();
+  double add_time = t.stop();
+  t.start();
+  fixed_binary_counter<plus_op> range((plus_op()), 0);
+  range.add_range(values.begin(), values.end());
+  uint64_t y = range.reduce();
+  double range_time = t.stop();
+  std::cout << "fixed_binary_counter, " << n << " values, ns per value: add "
+            << std::setprecision(2) << add_time / double(n) << ", add_range " << range_time / double(n)
+            << (x == y ? "" : " *** WRONG ***") << std::endl;
+}
+
+int main() {
+  std::cout << "add_range builds the tree of add: " << (check_add_range() ? "ok" : "*** WRONG ***") << std::endl;
+  std::cout << "mergesort_linked is stable: " << (check_stable() ? "ok" : "*** WRONG ***") << std::endl;
+  time_add_range(size_t(1) << 24);
+
+  std::cout << "ns and comparisons per node" << std::endl;
+  std::cout << std::setw(10) << "n" << std::setw(10) << "input" << std::setw(18) << "one node"
+            << std::setw(18) << "runs of 16" << std::endl;
+  for (size_t n = 1024; n <= (size_t(1) << 22); n *= 16) {
+    std::vector<int> values(n);
+    for (int sorted = 0; sorted < 2; ++sorted) {
+      if (sorted) iota(values.begin(), values.end());
+      else random_iota(values.begin(), values.end());
+      std::cout << std::setw(10) << n << std::setw(10) << (sorted ? "sorted" : "random");
+      time_sort(mergesort_linked_nodes_n<I, size_t, counting_less>, values);
+      time_sort(mergesort_linked_n<I, size_t, counting_less>, values);
+      std::cout << std::endl;
+    }
+  }
+}
@@ -14,4 +14,7 @@ int main() {
   print_range(list, nil);
   list = mergesort_linked(list, nil, std::less<int>());
   print_range(list, nil);
+  list = generate_list(vec.begin(), vec.end(), nil);
+  list = mergesort_linked_parallel(list, nil, std::less<int>(), 4);
+  print_range(list, nil);
 }
@@ -0,0 +1,54 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include "algorithm.h"
+#include "list_pool.h"
+#include "list_algorithm.h"
+
+// mergesort_linked against mergesort_linked_parallel (merge tree) and
+// mergesort_linked_parallel_balanced (reduction engine) on a list of 16M
+// ints, from 1 thread to all cores; wall clock time
+
+typedef list_pool<int, uint32_t> pool_type;
+typedef pool_type::iterator I;
+
+// ns per node; threads == 0 is the serial mergesort_linked
+void time_sort(I (*sort)(I, I, std::less<int>, unsigned), unsigned threads,
+               const std::vector<int>& values) {
+  // a fresh pool, so every run sees the same node layout
+  pool_type pool;
+  pool.reserve(values.size());
+  I nil(pool);
+  I list = generate_list(values.begin(), values.end(), nil);
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  list = threads == 0 ? mergesort_linked(list, nil, std::less<int>())
+                      : sort(list, nil, std::less<int>(), threads);
+  std::chrono::duration<double, std::nano> time = std::chrono::steady_clock::now() - start;
+  bool sorted = std::is_sorted(list, nil) && size_t(std::distance(list, nil)) == values.size();
+  std::cout << std::setw(12) << time.count() / double(values.size()) << (sorted ? "" : " *** WRONG ***");
+}
+
+int main() {
+  const size_t n(16 * 1000 * 1000);
+  std::vector<int> values(n);
+  random_iota(values.begin(), values.end());
+
+  unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+  std::cout << n << " nodes, ns per node" << std::endl;
+  std::cout << std::setw(20) << "" << std::setw(12) << "merge tree" << std::setw(12) << "engine" << std::endl;
+  std::cout << std::setw(20) << "mergesort_linked";
+  time_sort(0, 0, values);
+  std::cout << std::endl;
+  for (unsigned threads = 1; threads <= cores;
+       threads = threads == cores ? cores + 1 : std::min(2 * threads, cores)) {
+    std::cout << std::setw(12) << threads << " threads";
+    time_sort(mergesort_linked_parallel<I, std::less<int> >, threads, values);
+    time_sort(mergesort_linked_parallel_balanced<I, std::less<int> >, threads, values);
+    std::cout << std::endl;
+  }
+}
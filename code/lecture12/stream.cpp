@@ -0,0 +1,56 @@
+#include <iostream>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <cstdlib>
+#include <vector>
+#include "algorithm.h"
+#include "timer.h"
+#include "binary_counter.h"
+
+// running and sliding window min-2 over a stream of ints
+
+struct op_smallest_2
+{
+  typedef std::pair<int, int> argument_type;
+  argument_type operator()(const argument_type& x, const argument_type& y) const {
+    if (y.first < x.first) return argument_type(y.first, std::min(x.first, y.second));
+    return argument_type(x.first, std::min(x.second, y.first));
+  }
+};
+
+int main() {
+  const size_t n(1000 * 1000);
+  const int infinity(n);
+  const std::pair<int, int> zero(infinity, infinity);
+  std::vector<int> stream(n);
+  random_iota(stream.begin(), stream.end());
+
+  streaming_binary_counter<op_smallest_2> counter((op_smallest_2()), zero);
+  timer t;
+  t.start();
+  int checksum = 0;
+  for (size_t i = 0; i < n; ++i) {
+    counter.add(std::make_pair(stream[i], infinity));
+    checksum += counter.reduce().second;
+  }
+  double time = t.stop();
+  std::pair<int, int> result = counter.reduce();
+  std::cout << "running min-2 after " << n << " values: " << result.first << " " << result.second
+            << ", " << time / double(n) << " ns per add and query" << std::endl;
+
+  // keep at least window values; drop the oldest batch when it fits in the excess
+  const uint64_t window(1000);
+  streaming_binary_counter<op_smallest_2> sliding((op_smallest_2()), zero);
+  for (size_t i = 0; i < n; ++i) {
+    sliding.add(std::make_pair(stream[i], infinity));
+    while (sliding.size() - sliding.oldest_size() >= window) sliding.pop_oldest();
+  }
+  size_t covered = sliding.size();
+  std::vector<int> tail(stream.end() - covered, stream.end());
+  std::partial_sort(tail.begin(), tail.begin() + 2, tail.end());
+  result = sliding.reduce();
+  std::cout << "min-2 of the last " << covered << " values: " << result.first << " " << result.second
+            << (result == std::make_pair(tail[0], tail[1]) ? "" : " *** WRONG ***") << std::endl;
+  if (checksum == 1) std::cout << checksum;
+}
@@ -0,0 +1,265 @@
+#ifndef DLIST_POOL_H
+#define DLIST_POOL_H
+
+#include <vector>
+#include <cstddef>
+#include <iterator>
+
+// Doubly linked variant of list_pool: the same index handles (0 is end)
+// and free list reuse, with the predecessor links kept in a parallel
+// array so that any node can be unlinked or spliced in constant time.
+// end() is shared by all lists and has no predecessor.
+
+// Requirements on T: semiregular.
+// Requirements on N: integral
+template <typename T, typename N = std::size_t>
+class dlist_pool {
+public:
+  typedef N list_type;
+  typedef T value_type;
+
+private:
+
+  struct node_t {
+    T value;
+    list_type next;
+  };
+
+  std::vector<node_t> pool;
+  std::vector<list_type> prev_links;
+
+  node_t& node(list_type x) {
+    return pool[x - 1];
+  }
+  const node_t& node(list_type x) const {
+    return pool[x - 1];
+  }
+
+  list_type new_list() {
+    pool.push_back(node_t());
+    prev_links.push_back(end());
+    return list_type(pool.size());
+  }
+
+  list_type free_list;
+
+ public:
+  typedef typename std::vector<node_t>::size_type size_type;
+
+  list_type end() const {
+    return list_type(0);
+  }
+
+  bool is_end(list_type x) const {
+    return x == end();
+  }
+
+  bool empty() const {
+    return pool.empty();
+  }
+
+  size_type size() const {
+    return pool.size();
+  }
+
+  size_type capacity() const {
+    return pool.capacity();
+  }
+
+  void reserve(size_type n) {
+    pool.reserve(n);
+    prev_links.reserve(n);
+  }
+
+  dlist_pool() {
+    free_list = end();
+  }
+
+  dlist_pool(size_type n) {
+    free_list = end();
+    reserve(n);
+  }
+
+  T& value(list_type x) {
+    return node(x).value;
+  }
+
+  const T& value(list_type x) const {
+    return node(x).value;
+  }
+
+  list_type& next(list_type x) {
+    return node(x).next;
+  }
+  const list_type& next(list_type x) const {
+    return node(x).next;
+  }
+
+  list_type& prev(list_type x) {
+    return prev_links[x - 1];
+  }
+  const list_type& prev(list_type x) const {
+    return prev_links[x - 1];
+  }
+
+  // makes y the successor of x; either may be end(). The old successor
+  // of x loses its predecessor, so that relinking (as set_successor does)
+  // never leaves a stale one behind for unlink.
+  void link(list_type x, list_type y) {
+    if (!is_end(x)) {
+      list_type old = next(x);
+      if (!is_end(old) && prev(old) == x) prev(old) = end();
+      next(x) = y;
+    }
+    if (!is_end(y)) prev(y) = x;
+  }
+
+  // removes [front, back] from its list, joining its neighbours
+  // returns: the node that followed back
+  list_type unlink(list_type front, list_type back) {
+    list_type tail = next(back);
+    link(prev(front), tail);
+    prev(front) = end();
+    next(back) = end();
+    return tail;
+  }
+
+  list_type unlink(list_type x) {
+    return unlink(x, x);
+  }
+
+  // moves [front, back] from its list to just after x
+  void splice_after(list_type x, list_type front, list_type back) {
+    // precondition: x is not in [front, back]
+    unlink(front, back);
+    link(back, next(x));
+    link(x, front);
+  }
+
+  list_type free(list_type front, list_type back) {
+    if (is_end(front)) return end();
+    list_type tail = unlink(front, back);
+    next(back) = free_list;
+    free_list = front;
+    return tail;
+  }
+
+  list_type free(list_type x) {
+    return free(x, x);
+  }
+
+  list_type allocate(const T& val, list_type tail) {
+    // precondition: is_end(tail) || is_end(prev(tail))
+    list_type list = free_list;
+    if (is_end(free_list)) {
+      list = new_list();
+    } else {
+      free_list = next(free_list);
+    }
+    value(list) = val;
+    prev(list) = end();
+    next(list) = end();
+    link(list, tail);
+    return list;
+  }
+
+  // inserts a new node after x
+  list_type insert_after(list_type x, const T& val) {
+    list_type tail = next(x);
+    list_type list = allocate(val, end());
+    link(list, tail);
+    link(x, list);
+    return list;
+  }
+
+  struct iterator {
+    typedef typename dlist_pool::value_type value_type;
+    typedef typename dlist_pool::list_type difference_type;
+    typedef std::bidirectional_iterator_tag iterator_category;
+
+    typedef value_type& reference;
+    typedef value_type* pointer;
+
+    dlist_pool* pool;
+    typename dlist_pool::list_type node;
+
+    iterator() {} // creates a partially formed value
+    iterator(dlist_pool& p, typename dlist_pool::list_type node) :
+      pool(&p), node(node) {}
+    iterator(dlist_pool& p) : pool(&p), node(p.end()) {}
+
+    reference operator*() const {
+      return pool->value(node);
+    }
+
+    pointer operator->() const {
+      return &**this;
+    }
+
+    iterator& operator++() {
+      node = pool->next(node);
+      return *this;
+    }
+
+    iterator operator++(int) {
+      iterator tmp(*this);
+      ++*this;
+      return tmp;
+    }
+
+    // precondition: node is not end and not the first node of its list
+    iterator& operator--() {
+      node = pool->prev(node);
+      return *this;
+    }
+
+    iterator operator--(int) {
+      iterator tmp(*this);
+      --*this;
+      return tmp;
+    }
+
+    friend
+    bool operator==(const iterator& x, const iterator& y) {
+      // assert(x.pool == y.pool);
+      return x.node == y.node;
+    }
+
+    friend
+    bool operator!=(const iterator& x, const iterator& y) {
+      return !(x == y);
+    }
+
+    // extends the interface to Linked Iterator:
+
+    friend
+    void set_successor(iterator x, iterator y) {
+      // assert(x.p == y.p)
+      x.pool->link(x.node, y.node);
+    }
+
+    // extend the interface to Linked List Iterator:
+
+    friend
+    void push_front(iterator& x, const T& value) {
+      x.node = x.pool->allocate(value, x.node);
+    }
+
+    friend
+    void push_back(iterator& x, const T& value) {
+      x.pool->insert_after(x.node, value);
+    }
+
+    friend
+    iterator unlink(iterator& x) {
+      return iterator(*x.pool, x.pool->unlink(x.node));
+    }
+
+    friend
+    iterator free(iterator& x) {
+      return iterator(*x.pool, x.pool->free(x.node));
+    }
+  };
+};
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef EYTZINGER_H
+#define EYTZINGER_H
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+#include "search.h"
+
+// A read-only search index over a sorted range, laid out in Eytzinger
+// (breadth first) order: the root at 1, the children of k at 2k and
+// 2k + 1. The first levels of every search share a few cache lines, and
+// the 64 bytes of descendants four levels down from k (for 4-byte values)
+// sit together, so they are prefetched a few steps before they are
+// needed. The answers are positions in the original sorted range, kept
+// in a parallel array of type N that is read once per search.
+
+// Requirements on T: semiregular.
+// Requirements on Compare: StrictWeakOrdering on T.
+// Requirements on N: integral, able to hold the size of the range.
+template <typename T, typename Compare = std::less<T>, typename N = std::size_t>
+class eytzinger_index {
+public:
+  typedef T value_type;
+  typedef N size_type;
+
+private:
+  // the values one cache line holds: the descendants of k at the depth of
+  // k * block are block consecutive values
+  static const std::size_t cache_line = 64;
+  static const std::size_t block = cache_line / sizeof(T) ? cache_line / sizeof(T) : 1;
+
+  // values[offset + k] is node k, with values[offset] cache line aligned
+  std::vector<T> values;
+  std::size_t offset;
+  std::vector<N> positions; // positions[k] is the sorted position of node k
+  N n;
+  Compare cmp;
+
+  const T* tree() const { return &values[offset]; }
+
+  template <typename I>
+  // I is InputIterator
+  // lays out the subtree of k by an in-order walk over the sorted range
+  I build(std::size_t k, I first, N& position) {
+    if (k > std::size_t(n)) return first;
+    first = build(2 * k, first, position);
+    values[offset + k] = *first;
+    ++first;
+    positions[k] = position++;
+    first = build(2 * k + 1, first, position);
+    return first;
+  }
+
+  // the node where the search ended, as the path it took: every right
+  // turn after the last left turn is undone, and the node of that left
+  // turn is the answer (0 if the path never turned left)
+  static std::size_t last_left_turn(std::size_t k) {
+#if defined(__GNUC__)
+    return k >> __builtin_ffsll(~(unsigned long long)k);
+#else
+    while (k & 1) k >>= 1;
+    return k >> 1;
+#endif
+  }
+
+  template <typename P>
+  // P is a UnaryPredicate on T, true for a prefix of the sorted range
+  N partition_point(P pred) const {
+    const T* t = tree();
+    std::size_t k = 1;
+    while (k <= std::size_t(n)) {
+      // below the leaves there is nothing to prefetch: stay inside values
+      SEARCH_PREFETCH(t + std::min(k * block, std::size_t(n)));
+      k = 2 * k + std::size_t(pred(t[k]));
+    }
+    k = last_left_turn(k);
+    return k ? positions[k] : n;
+  }
+
+public:
+  template <typename I>
+  // I is ForwardIterator with value type T
+  eytzinger_index(I first, I last, const Compare& cmp = Compare()) : cmp(cmp) {
+    // precondition: is_sorted(first, last, cmp)
+    n = N(std::distance(first, last));
+    values.resize(n + 1 + block);
+    // a copy of the index may lose the alignment, but not the layout
+    offset = 0;
+    while (offset < block && std::size_t(&values[offset]) % cache_line) ++offset;
+    if (offset == block) offset = 0;
+    positions.resize(n + 1);
+    N position(0);
+    build(1, first, position);
+  }
+
+  size_type size() const { return n; }
+
+  bool empty() const { return n == N(0); }
+
+  // the positions in the sorted range of the first element not less
+  // than a, of the first element greater than a, and of both
+
+  size_type lower_bound(const T& a) const {
+    return partition_point(lower_bound_predicate<Compare, T>(cmp, a));
+  }
+
+  size_type upper_bound(const T& a) const {
+    return partition_point(upper_bound_predicate<Compare, T>(cmp, a));
+  }
+
+  std::pair<size_type, size_type> equal_range(const T& a) const {
+    return std::make_pair(lower_bound(a), upper_bound(a));
+  }
+};
+
+#endif
@@ -0,0 +1,55 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+#include <stdint.h>
+#include "timer.h"
+#include "search.h"
+
+// lower_bound on sorted int32_t arrays from 4 KB to 1 GB: the generic
+// partition_point_n, std::lower_bound and the branchless lower_bound_n that
+// pointers with std::less now get, in millions of random queries per second
+
+typedef int32_t T;
+
+enum search_kind { generic, standard, branchless };
+
+double queries_per_second(const std::vector<T>& v, const std::vector<T>& queries, search_kind kind) {
+  const T* first = &v[0];
+  std::ptrdiff_t n = v.size();
+  std::ptrdiff_t sum = 0;
+  timer t;
+  t.start();
+  for (size_t i = 0; i < queries.size(); ++i) {
+    const T* p;
+    if (kind == generic) p = partition_point_n(first, n, lower_bound_predicate<std::less<T>, T>(std::less<T>(), queries[i]));
+    else if (kind == standard) p = std::lower_bound(first, first + n, queries[i]);
+    else p = lower_bound_n(first, n, queries[i], std::less<T>());
+    sum += p - first;
+  }
+  double time = t.stop();
+  if (sum == -1) std::cout << sum; // keep the searches alive
+  return 1000. * double(queries.size()) / time;
+}
+
+int main() {
+  const size_t max_bytes(size_t(1) << 30);
+  const size_t query_count(1 << 20);
+  std::cout << std::setw(12) << "bytes" << std::setw(12) << "generic"
+            << std::setw(12) << "std" << std::setw(12) << "branchless" << std::endl;
+  for (size_t bytes = 4096; bytes <= max_bytes; bytes *= 4) {
+    size_t n = bytes / sizeof(T);
+    // the even numbers, so half of the queries are not in the array
+    std::vector<T> v(n);
+    for (size_t i = 0; i < n; ++i) v[i] = T(2 * i);
+    std::vector<T> queries(query_count);
+    for (size_t i = 0; i < query_count; ++i) queries[i] = T((uint64_t(std::rand()) << 16 ^ std::rand()) % (2 * n));
+    std::cout << std::setw(12) << bytes << std::fixed << std::setprecision(1)
+              << std::setw(12) << queries_per_second(v, queries, generic)
+              << std::setw(12) << queries_per_second(v, queries, standard)
+              << std::setw(12) << queries_per_second(v, queries, branchless) << std::endl;
+  }
+}
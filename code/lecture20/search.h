@@ -2,7 +2,14 @@
 #define SEARCH_H
 
 #include <algorithm>
+#include <cstddef>
+#include <functional>
 #include <iterator>
+#include <stdint.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 template <typename I, typename P>
 // I is InputIterator, P is UnaryPredicate
@@ -246,4 +253,246 @@ I upper_bound(I first, I last,
   return upper_bound_n(first, std::distance(first, last));
 }
 
+/****************** contiguous arithmetic keys ****************************/
+
+// lower_bound_n and upper_bound_n on pointers with std::less: a binary
+// search without a data-dependent branch (the new start is a conditional
+// move, and both candidates for the next probe are prefetched), finished
+// by a linear count of the last few elements, with AVX2 for the types
+// that have it. Both bounds of a window in a sorted range are found by
+// counting: the bound is the start plus the number of elements before it.
+
+#if defined(__GNUC__)
+#define SEARCH_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define SEARCH_PREFETCH(address)
+#endif
+
+template <typename T>
+// T is totally ordered by <
+// counts of the elements of a window that precede a lower bound (x < a)
+// or an upper bound (!(a < x)); the generic version is scalar and has no
+// window, so the binary search goes down to a single element
+struct search_count
+{
+  static const int linear_size = 1;
+
+  static std::ptrdiff_t less(const T* first, std::ptrdiff_t n, const T& a) {
+    std::ptrdiff_t count = 0;
+    for (std::ptrdiff_t i = 0; i < n; ++i) count += first[i] < a;
+    return count;
+  }
+
+  static std::ptrdiff_t not_greater(const T* first, std::ptrdiff_t n, const T& a) {
+    std::ptrdiff_t count = 0;
+    for (std::ptrdiff_t i = 0; i < n; ++i) count += !(a < first[i]);
+    return count;
+  }
+};
+
+#if defined(__AVX2__)
+
+inline
+std::ptrdiff_t search_popcount(int mask) {
+#if defined(__GNUC__)
+  return __builtin_popcount(mask);
+#else
+  return _mm_popcnt_u32(mask);
+#endif
+}
+
+// the AVX2 windows are two cache lines; the elements past the last whole
+// vector are counted one at a time
+
+template <>
+struct search_count<int32_t>
+{
+  static const int linear_size = 32;
+
+  static std::ptrdiff_t less(const int32_t* first, std::ptrdiff_t n, int32_t a) {
+    __m256i key = _mm256_set1_epi32(a);
+    std::ptrdiff_t count = 0;
+    std::ptrdiff_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+      __m256i x = _mm256_loadu_si256((const __m256i*)(first + i));
+      count += search_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(key, x))));
+    }
+    for (; i < n; ++i) count += first[i] < a;
+    return count;
+  }
+
+  static std::ptrdiff_t not_greater(const int32_t* first, std::ptrdiff_t n, int32_t a) {
+    __m256i key = _mm256_set1_epi32(a);
+    std::ptrdiff_t count = 0;
+    std::ptrdiff_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+      __m256i x = _mm256_loadu_si256((const __m256i*)(first + i));
+      count += 8 - search_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(x, key))));
+    }
+    for (; i < n; ++i) count += !(a < first[i]);
+    return count;
+  }
+};
+
+template <>
+struct search_count<int64_t>
+{
+  static const int linear_size = 16;
+
+  static std::ptrdiff_t less(const int64_t* first, std::ptrdiff_t n, int64_t a) {
+    __m256i key = _mm256_set1_epi64x(a);
+    std::ptrdiff_t count = 0;
+    std::ptrdiff_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+      __m256i x = _mm256_loadu_si256((const __m256i*)(first + i));
+      count += search_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(key, x))));
+    }
+    for (; i < n; ++i) count += first[i] < a;
+    return count;
+  }
+
+  static std::ptrdiff_t not_greater(const int64_t* first, std::ptrdiff_t n, int64_t a) {
+    __m256i key = _mm256_set1_epi64x(a);
+    std::ptrdiff_t count = 0;
+    std::ptrdiff_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+      __m256i x = _mm256_loadu_si256((const __m256i*)(first + i));
+      count += 4 - search_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(x, key))));
+    }
+    for (; i < n; ++i) count += !(a < first[i]);
+    return count;
+  }
+};
+
+template <>
+struct search_count<float>
+{
+  static const int linear_size = 32;
+
+  static std::ptrdiff_t less(const float* first, std::ptrdiff_t n, float a) {
+    __m256 key = _mm256_set1_ps(a);
+    std::ptrdiff_t count = 0;
+    std::ptrdiff_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+      count += search_popcount(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(first + i), key, _CMP_LT_OQ)));
+    }
+    for (; i < n; ++i) count += first[i] < a;
+    return count;
+  }
+
+  static std::ptrdiff_t not_greater(const float* first, std::ptrdiff_t n, float a) {
+    __m256 key = _mm256_set1_ps(a);
+    std::ptrdiff_t count = 0;
+    std::ptrdiff_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+      count += search_popcount(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(first + i), key, _CMP_NGT_UQ)));
+    }
+    for (; i < n; ++i) count += !(a < first[i]);
+    return count;
+  }
+};
+
+template <>
+struct search_count<double>
+{
+  static const int linear_size = 16;
+
+  static std::ptrdiff_t less(const double* first, std::ptrdiff_t n, double a) {
+    __m256d key = _mm256_set1_pd(a);
+    std::ptrdiff_t count = 0;
+    std::ptrdiff_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+      count += search_popcount(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(first + i), key, _CMP_LT_OQ)));
+    }
+    for (; i < n; ++i) count += first[i] < a;
+    return count;
+  }
+
+  static std::ptrdiff_t not_greater(const double* first, std::ptrdiff_t n, double a) {
+    __m256d key = _mm256_set1_pd(a);
+    std::ptrdiff_t count = 0;
+    std::ptrdiff_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+      count += search_popcount(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(first + i), key, _CMP_NGT_UQ)));
+    }
+    for (; i < n; ++i) count += !(a < first[i]);
+    return count;
+  }
+};
+
+#endif
+
+template <typename T, typename N, typename P>
+// N is Integral
+// P is a UnaryPredicate on T, true for a prefix of [first, first + n)
+// narrows [first, first + n) to a window of at most linear_size elements
+// that contains the partition point; returns its start and sets n to
+// its size
+const T* partition_point_branchless_n(const T* first, N& n, P pred, N linear_size) {
+  while (n > linear_size) {
+    N half = n >> 1;
+    N next_half = (n - half) >> 1;
+    SEARCH_PREFETCH(first + next_half);
+    SEARCH_PREFETCH(first + half + next_half);
+    // [first, first + n] holds the partition point, and so does
+    // [first + half, first + n] if pred(first[half]), else [first, first + n - half]
+    first = pred(first[half]) ? first + half : first;
+    n -= half;
+  }
+  return first;
+}
+
+template <typename T, typename N>
+// T is totally ordered by <
+// N is Integral
+const T* lower_bound_branchless_n(const T* first, N n, const T& a) {
+  // precondition: is_sorted_n(first, n)
+  if (n == N(0)) return first;
+  first = partition_point_branchless_n(first, n, lower_bound_predicate<std::less<T>, T>(std::less<T>(), a),
+                                       N(search_count<T>::linear_size));
+  return first + search_count<T>::less(first, std::ptrdiff_t(n), a);
+}
+
+template <typename T, typename N>
+// T is totally ordered by <
+// N is Integral
+const T* upper_bound_branchless_n(const T* first, N n, const T& a) {
+  // precondition: is_sorted_n(first, n)
+  if (n == N(0)) return first;
+  first = partition_point_branchless_n(first, n, upper_bound_predicate<std::less<T>, T>(std::less<T>(), a),
+                                       N(search_count<T>::linear_size));
+  return first + search_count<T>::not_greater(first, std::ptrdiff_t(n), a);
+}
+
+// lower_bound_n and upper_bound_n with std::less pick the branchless search
+// for pointers
+
+template <typename T, typename N>
+// N is Integral
+inline
+const T* lower_bound_n(const T* first, N n, const T& a, std::less<T>) {
+  return lower_bound_branchless_n(first, n, a);
+}
+
+template <typename T, typename N>
+// N is Integral
+inline
+T* lower_bound_n(T* first, N n, const T& a, std::less<T>) {
+  return const_cast<T*>(lower_bound_branchless_n(static_cast<const T*>(first), n, a));
+}
+
+template <typename T, typename N>
+// N is Integral
+inline
+const T* upper_bound_n(const T* first, N n, const T& a, std::less<T>) {
+  return upper_bound_branchless_n(first, n, a);
+}
+
+template <typename T, typename N>
+// N is Integral
+inline
+T* upper_bound_n(T* first, N n, const T& a, std::less<T>) {
+  return const_cast<T*>(upper_bound_branchless_n(static_cast<const T*>(first), n, a));
+}
+
 #endif // SEARCH_H
@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include "algorithm.h"
+#include "insertion_sort.h"
+#include "dlist_pool.h"
+
+typedef dlist_pool<int> pool_type;
+typedef pool_type::iterator I;
+
+// every node of the list is the predecessor of its successor, and the
+// head has none
+bool check_links(const pool_type& pool, pool_type::list_type list) {
+  pool_type::list_type previous = pool.end();
+  while (!pool.is_end(list)) {
+    if (pool.prev(list) != previous) return false;
+    previous = list;
+    list = pool.next(list);
+  }
+  return true;
+}
+
+// relinks 1 2 3 4 5 6 with set_successor: reversed, then cut after the
+// second node; unlinking a node of each half must leave the other alone
+bool test_relink() {
+  pool_type pool;
+  I nil(pool);
+  I list(nil);
+  for (int i = 6; i > 0; --i) push_front(list, i);
+  I reversed(nil);
+  while (list != nil) {
+    I next = successor(list);
+    set_successor(list, reversed);
+    reversed = list;
+    list = next;
+  }
+  // 6 5 4 3 2 1
+  I back = successor(reversed);
+  I front = successor(back);
+  set_successor(back, nil);
+  // 6 5 and 4 3 2 1
+  bool ok = check_links(pool, reversed.node) && check_links(pool, front.node);
+  I rest = unlink(front);
+  ok = ok && check_links(pool, reversed.node) && check_links(pool, rest.node);
+  ok = ok && *reversed == 6 && *successor(reversed) == 5 && successor(successor(reversed)) == nil;
+  ok = ok && *rest == 3 && *successor(rest) == 2 && *successor(successor(rest)) == 1;
+  pool.unlink(successor(rest).node);
+  ok = ok && check_links(pool, rest.node) && *successor(rest) == 1;
+  return ok;
+}
+
+int main() {
+  std::vector<int> vec(17);
+  random_iota(vec.begin(), vec.end());
+
+  pool_type pool;
+  I nil(pool);
+  I list(nil);
+  for (std::vector<int>::reverse_iterator i = vec.rbegin(); i != vec.rend(); ++i) {
+    push_front(list, *i);
+  }
+  print_range(list, nil);
+  insertion_sort_classic(list, nil, std::less<int>());
+  print_range(list, nil);
+
+  // remove every third node without searching for its predecessor
+  I current = list;
+  ++current;
+  while (current != nil) {
+    I victim = current;
+    for (int i = 0; i < 3 && current != nil; ++i) ++current;
+    free(victim);
+  }
+  print_range(list, nil);
+
+  // move the second node to the back and reinsert into a freed slot
+  I second = successor(list);
+  I last = list;
+  while (successor(last) != nil) ++last;
+  pool.splice_after(last.node, second.node, second.node);
+  print_range(list, nil);
+  push_back(list, -1);
+  print_range(list, nil);
+  linear_insert(list, successor(list), std::less<int>());
+  print_range(list, nil);
+
+  bool ok = check_links(pool, list.node);
+  ok = test_relink() && ok;
+  std::cout << (ok ? "links: ok" : "links: Failed") << std::endl;
+  return ok ? 0 : 1;
+}
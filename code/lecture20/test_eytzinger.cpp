@@ -0,0 +1,47 @@
+#include <iostream>
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+#include <stdint.h>
+#include "eytzinger.h"
+
+// eytzinger_index against std::lower_bound, std::upper_bound and
+// std::equal_range on the sorted range it was built from: every length
+// up to 300, runs of equal values, queries below, between, on and above
+// them, and a descending order to test the comparison object
+
+template <typename T, typename Compare, typename N>
+bool test_eytzinger(const char* name, Compare cmp) {
+  bool ok = true;
+  for (std::size_t n = 0; n <= 300; ++n) {
+    std::vector<T> v(n);
+    for (std::size_t i = 0; i < n; ++i) v[i] = T(2 * (std::rand() % (n / 4 + 1)));
+    std::sort(v.begin(), v.end(), cmp);
+    eytzinger_index<T, Compare, N> index(v.begin(), v.end(), cmp);
+    if (index.size() != N(n) || index.empty() != (n == 0)) ok = false;
+    for (int q = -1; q <= int(n / 2) + 2; ++q) {
+      T a = T(q);
+      std::size_t lower = std::lower_bound(v.begin(), v.end(), a, cmp) - v.begin();
+      std::size_t upper = std::upper_bound(v.begin(), v.end(), a, cmp) - v.begin();
+      std::pair<N, N> range = index.equal_range(a);
+      if (std::size_t(index.lower_bound(a)) != lower || std::size_t(index.upper_bound(a)) != upper ||
+          std::size_t(range.first) != lower || std::size_t(range.second) != upper) {
+        if (ok) std::cout << name << ": Failed for n = " << n << ", a = " << q << std::endl;
+        ok = false;
+      }
+    }
+  }
+  if (ok) std::cout << name << ": ok" << std::endl;
+  return ok;
+}
+
+int main() {
+  bool ok = test_eytzinger<int32_t, std::less<int32_t>, uint32_t>("int32_t", std::less<int32_t>());
+  ok = test_eytzinger<int64_t, std::less<int64_t>, std::size_t>("int64_t", std::less<int64_t>()) && ok;
+  ok = test_eytzinger<double, std::less<double>, std::size_t>("double", std::less<double>()) && ok;
+  ok = test_eytzinger<char, std::less<char>, uint16_t>("char", std::less<char>()) && ok;
+  ok = test_eytzinger<int, std::greater<int>, std::size_t>("int, descending", std::greater<int>()) && ok;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+#include <iostream>
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+#include <stdint.h>
+#include "search.h"
+
+// lower_bound_n and upper_bound_n on pointers with std::less against
+// std::lower_bound and std::upper_bound: every length up to 300 (empty,
+// shorter than the linear window, a few windows), few distinct values so
+// that there are runs of ties, and queries below, between, on and above
+// them. Build with -mavx2 to test the vector counts as well.
+
+template <typename T>
+bool test_search(const char* type_name) {
+  bool ok = true;
+  for (std::size_t n = 0; n <= 300; ++n) {
+    std::vector<T> v(n + 1); // + 1: &v[0] is valid for n == 0
+    for (std::size_t i = 0; i < n; ++i) v[i] = T(2 * (std::rand() % (n / 4 + 1)));
+    std::sort(v.begin(), v.begin() + n);
+    T* first = &v[0];
+    const T* const_first = first;
+    for (int q = -1; q <= int(n / 2) + 2; ++q) {
+      T a = T(q);
+      std::ptrdiff_t lower = std::lower_bound(first, first + n, a) - first;
+      std::ptrdiff_t upper = std::upper_bound(first, first + n, a) - first;
+      if (lower_bound_n(first, n, a, std::less<T>()) - first != lower ||
+          lower_bound_n(const_first, n, a, std::less<T>()) - const_first != lower ||
+          upper_bound_n(first, n, a, std::less<T>()) - first != upper ||
+          upper_bound_n(const_first, n, a, std::less<T>()) - const_first != upper) {
+        if (ok) std::cout << type_name << ": Failed for n = " << n << ", a = " << q << std::endl;
+        ok = false;
+      }
+    }
+  }
+  if (ok) std::cout << type_name << ": ok" << std::endl;
+  return ok;
+}
+
+int main() {
+  bool ok = test_search<int32_t>("int32_t");
+  ok = test_search<int64_t>("int64_t") && ok;
+  ok = test_search<uint32_t>("uint32_t") && ok;
+  ok = test_search<short>("short") && ok;
+  ok = test_search<float>("float") && ok;
+  ok = test_search<double>("double") && ok;
+  return ok ? 0 : 1;
+}
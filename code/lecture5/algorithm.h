@@ -116,6 +116,14 @@ void valley(I first, I last)
   iota(middle, last);
 }
 
+template <RandomAccessIterator I>
+void sawtooth(I first, I last)
+{
+  // teeth of 16: ascending runs that a predictor learns, but the
+  // minimum and maximum candidates come back every few elements
+  segmented_iota(first, last, DifferenceType(I)(16));
+}
+
 template <ForwardIterator I, Integral N>
 std::pair<N, N>
 repeating_iota(I first, I last, N start = N(0), N step = N(1), N repetitions = N(1)) {
@@ -140,7 +148,8 @@ const char* function_name(void (*gen)(I, I)) {
       hill<I>,
       valley<I>,
       reverse_iota<I>, 
-      random_iota<I>
+      random_iota<I>,
+      sawtooth<I>
     };
   const char* names[] =
     {
@@ -148,7 +157,8 @@ const char* function_name(void (*gen)(I, I)) {
       "hill",
       "valley",
       "reverse_iota",
-      "random_iota"
+      "random_iota",
+      "sawtooth"
     };
   size_t number_of_generators = sizeof(generator)/sizeof(generator[0]);
   size_t index = std::find(generator, generator + number_of_generators, gen) - generator;
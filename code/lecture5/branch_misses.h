@@ -0,0 +1,75 @@
+/*-----------------------------------------------------------------------------
+ * Counting mispredicted branches of the calling thread
+ *----------------------------------------------------------------------------*/
+
+#ifndef BRANCH_MISSES_H
+#define BRANCH_MISSES_H
+
+#include <stdint.h>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// A hardware counter of branch misses in user code, through
+// perf_event_open. Where there is no such counter (other systems,
+// virtual machines, perf_event_paranoid too high) available() is false
+// and stop() returns 0.
+
+class branch_misses {
+private:
+    int fd;
+
+    // not copyable: the counter is owned
+    branch_misses(const branch_misses&);
+    branch_misses& operator=(const branch_misses&);
+
+public:
+    branch_misses() : fd(-1) {
+#if defined(__linux__)
+        struct perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = int(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~branch_misses() {
+#if defined(__linux__)
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    bool available() const {
+        return fd >= 0;
+    }
+
+    void start() {
+#if defined(__linux__)
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    uint64_t stop() {
+        uint64_t count = 0;
+#if defined(__linux__)
+        if (fd < 0) return 0;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &count, sizeof(count)) != ssize_t(sizeof(count))) count = 0;
+#endif
+        return count;
+    }
+};
+
+#endif
@@ -26,6 +26,7 @@
 #include "algorithm.h"
 #include "concepts.h"
 #include "minmax.h"
+#include "branch_misses.h"
 
 
 namespace course {
@@ -68,7 +69,7 @@ std::pair<double, double> minmax_comparisons(I first, I last) {
   {
     std::vector<T> seq(first, last);
     comparisons = 0;
-    m1 = minmax_element(seq.begin(), seq.end(), counting_less);
+    m1 = course::minmax_element(seq.begin(), seq.end(), counting_less);
     result.second = comparisons;
   }
   if (m0 != m1) std::cout << "Failed: different mins or maxs\n";
@@ -81,7 +82,7 @@ std::pair<double, double> minmax_times(I first, I last, size_t iterations) {
   typedef typename std::iterator_traits<I>::difference_type N;
   N n = std::distance(first, last);
   std::pair<double, double> result;
-  std::pair<I, I> m0, m1; 
+  std::pair<T*, T*> m0, m1; 
   double time;
   double nanoseconds = 1000000000.0 /  double(CLOCKS_PER_SEC);
   std::vector<T> seq(iterations * n);
@@ -97,7 +98,8 @@ std::pair<double, double> minmax_times(I first, I last, size_t iterations) {
   for (N i(0); i < iterations; ++i) std::copy(first, last, seq.begin() + i * n);
   time = clock();
   for (size_t i(0); i < iterations; ++i) {
-    m1 = minmax_element((&*seq.begin()) + i * n, (&*seq.begin()) + (i + 1) * n, std::less<T>());
+    // the scalar version: minmax_element on pointers with std::less is vectorized
+    m1 = course::minmax_element<T*, std::less<T> >((&*seq.begin()) + i * n, (&*seq.begin()) + (i + 1) * n, std::less<T>());
   }
   time = clock() - time; 
   result.second = (time * nanoseconds) / double(iterations); 
@@ -106,6 +108,31 @@ std::pair<double, double> minmax_times(I first, I last, size_t iterations) {
   return result;
 }
 
+template <typename I> 
+double minmax_simd_times(I first, I last, size_t iterations) {
+  typedef typename std::iterator_traits<I>::value_type T;
+  typedef typename std::iterator_traits<I>::difference_type N;
+  N n = std::distance(first, last);
+  std::pair<T*, T*> m0, m1; 
+  double time;
+  double nanoseconds = 1000000000.0 /  double(CLOCKS_PER_SEC);
+  std::vector<T> seq(iterations * n);
+
+  for (N i(0); i < iterations; ++i) std::copy(first, last, seq.begin() + i * n);
+  time = clock();
+  for (size_t i(0); i < iterations; ++i) {
+    m1 = minmax_element((&*seq.begin()) + i * n, (&*seq.begin()) + (i + 1) * n, std::less<T>());
+  }
+  time = clock() - time; 
+
+  m0 = course::minmax_element<T*, std::less<T> >(&*seq.begin(), &*seq.begin() + n, std::less<T>());
+  if (m0.first - &*seq.begin() != m1.first - (&*seq.begin() + (iterations - 1) * n) ||
+      m0.second - &*seq.begin() != m1.second - (&*seq.begin() + (iterations - 1) * n)) {
+    std::cout << "Failed: different mins or maxs\n";
+  }
+  return (time * nanoseconds) / double(iterations); 
+}
+
 double log2(double x) { return log(x) / log(2.0); }
 
 void print_comparisons(size_t n) {
@@ -124,16 +151,94 @@ void print_comparisons(size_t n) {
 
 template <typename T>
 void print_times(size_t n) {
-  std::cout << "\nTimes\n" << "\tn\t      minmax_simple\tminmax\t  gain (%)\t\n";
+  std::cout << "\nTimes\n" << "\tn\t      minmax_simple\tminmax\t  gain (%)\tminmax_simd\n";
   for (size_t i(64); i < n; i <<= 1) {
     std::vector<T> buffer(i);
     course::iota(buffer.begin(), buffer.end(), T(0)); // newer versions of std include iota
     std::srand ( unsigned (std::time( 0 ) ));
     std::random_shuffle(buffer.begin(), buffer.end());
     std::pair<double, double> result = minmax_times(buffer.begin(), buffer.end(), n / i);
+    double simd = minmax_simd_times(buffer.begin(), buffer.end(), n / i);
     std::cout << std::setw(9) << i  << std::fixed  
 	      << std::setprecision(2)  << "\t\t" << result.first / i << "\t\t" << result.second / i 
-	      << "\t\t" << std::setprecision(0) << (1 - result.second / result.first) * 100  << std::endl;
+	      << "\t\t" << std::setprecision(0) << (1 - result.second / result.first) * 100
+	      << "\t\t" << std::setprecision(2) << simd / i << std::endl;
+  }
+}
+
+/****************************************************************************************
+                                 INPUT PATTERNS
+****************************************************************************************/
+
+template <typename T>
+std::pair<T*, T*> minmax_simple_kernel(T* first, T* last, std::less<T> cmp) {
+  return minmax_element_simple(first, last, cmp);
+}
+
+template <typename T>
+std::pair<T*, T*> minmax_kernel(T* first, T* last, std::less<T> cmp) {
+  return course::minmax_element<T*, std::less<T> >(first, last, cmp);
+}
+
+template <typename T>
+std::pair<T*, T*> minmax_branchless_kernel(T* first, T* last, std::less<T> cmp) {
+  return minmax_element_branchless(first, last, cmp);
+}
+
+template <typename T>
+std::pair<T*, T*> minmax_simd_kernel(T* first, T* last, std::less<T> cmp) {
+  return minmax_element(first, last, cmp);
+}
+
+template <typename T>
+std::pair<T*, T*> minmax_auto_kernel(T* first, T* last, std::less<T> cmp) {
+  return minmax_element_auto(first, last, cmp);
+}
+
+// time and branch misses per element of each kernel on each input pattern
+template <typename T>
+void print_pattern_times(size_t n, size_t size) {
+  typedef typename std::vector<T>::iterator I;
+  typedef std::pair<T*, T*> (*kernel)(T*, T*, std::less<T>);
+  void (*generators[])(I, I) = {
+    iota<I>, reverse_iota<I>, hill<I>, valley<I>, sawtooth<I>, random_iota<I>
+  };
+  kernel kernels[] = {
+    minmax_simple_kernel<T>, minmax_kernel<T>, minmax_branchless_kernel<T>,
+    minmax_simd_kernel<T>, minmax_auto_kernel<T>
+  };
+  const char* names[] = {"simple", "minmax", "branchless", "simd", "auto"};
+  const size_t number_of_kernels = sizeof(kernels) / sizeof(kernels[0]);
+  size_t iterations = std::max(size_t(1), n / size);
+  double nanoseconds = 1000000000.0 / double(CLOCKS_PER_SEC);
+  branch_misses misses;
+
+  std::cout << "\nInput patterns, n = " << size << ": ns per element"
+            << (misses.available() ? " / branch misses per element" : " (no branch miss counter)")
+            << "\n" << std::setw(14) << "";
+  for (size_t k = 0; k < number_of_kernels; ++k) std::cout << std::setw(14) << names[k];
+  std::cout << std::setw(14) << "changes" << std::endl;
+
+  std::vector<T> buffer(size);
+  for (size_t g = 0; g < sizeof(generators) / sizeof(generators[0]); ++g) {
+    generators[g](buffer.begin(), buffer.end());
+    T* first = &*buffer.begin();
+    T* last = first + size;
+    std::pair<T*, T*> expected = minmax_kernel(first, last, std::less<T>());
+    std::cout << std::setw(14) << function_name(generators[g]);
+    for (size_t k = 0; k < number_of_kernels; ++k) {
+      std::pair<T*, T*> result;
+      double time = clock();
+      misses.start();
+      for (size_t i = 0; i < iterations; ++i) result = kernels[k](first, last, std::less<T>());
+      double missed = double(misses.stop());
+      time = clock() - time;
+      std::cout << std::setw(misses.available() ? 7 : 14) << std::fixed << std::setprecision(2)
+                << time * nanoseconds / double(iterations * size);
+      if (misses.available()) std::cout << std::setw(7) << missed / double(iterations * size);
+      if (result != expected) std::cout << " Failed: different mins or maxs";
+    }
+    std::cout << std::setw(14) << pair_order_changes(first, last, std::less<T>()) << std::endl;
   }
 }
 } // end of namespace course
@@ -141,6 +246,7 @@ void print_times(size_t n) {
 int main() {
   course::print_comparisons(128 * 1024 * 1024);
   course::print_times<uint64_t>(128 * 1024 * 1024);
+  course::print_pattern_times<uint64_t>(128 * 1024 * 1024, 64 * 1024);
 }
 
 
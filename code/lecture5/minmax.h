@@ -1,4 +1,13 @@
 
+#include <functional>
+#include <limits>
+#include <utility>
+#include <stdint.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 /*
 min<int, std::greater<int> >
 min<int>
@@ -171,4 +180,581 @@ std::pair<I, I> minmax_element(I first, I last, Compare cmp) {
     return std::make_pair(min_el, max_el);
 }
 
+// The same result as minmax_element with two comparisons per element but
+// no data-dependent branches: both updates are selects, which compile to
+// conditional moves. On random data the pairing of minmax_element costs
+// a mispredicted branch every other pair; here nothing is mispredicted.
+
+template <typename I, typename Compare>
+// requires I is a ForwardIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+std::pair<I, I> minmax_element_branchless(I first, I last, Compare cmp) {
+    if (first == last) return std::make_pair(last, last);
+    I min_el = first;
+    I max_el = first;
+    while (++first != last) {
+        min_el = cmp(*first, *min_el) ? first : min_el;
+        max_el = cmp(*first, *max_el) ? max_el : first;
+    }
+    return std::make_pair(min_el, max_el);
+}
+
+template <typename I, typename Compare>
+// requires I is a RandomAccessIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+// returns: the fraction of adjacent pairs, in a few windows spread over
+// the range, that are ordered differently from the pair before them,
+// i.e. how often the pair comparison of minmax_element changes outcome
+double pair_order_changes(I first, I last, Compare cmp) {
+    typedef typename std::iterator_traits<I>::difference_type N;
+    const N windows = 4;
+    const N window_pairs = 64;
+    N n = last - first;
+    if (n < 2 * (window_pairs + 1)) return 0.0;
+    N changes = 0;
+    N samples = 0;
+    for (N w = 0; w < windows; ++w) {
+        I p = first + (n - 2 * (window_pairs + 1)) * w / (windows - 1);
+        bool previous = cmp(p[1], p[0]);
+        for (N i = 1; i <= window_pairs; ++i) {
+            p += 2;
+            bool current = cmp(p[1], p[0]);
+            changes += current != previous;
+            previous = current;
+            ++samples;
+        }
+    }
+    return double(changes) / double(samples);
+}
+
+template <typename I, typename Compare>
+// requires I is a RandomAccessIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+// minmax_element when the pair comparisons are predictable (sorted runs,
+// hills, saw teeth) and minmax_element_branchless when they are not
+std::pair<I, I> minmax_element_auto(I first, I last, Compare cmp) {
+    // below a few thousand elements sampling costs more than it saves
+    if (last - first < 4096 || pair_order_changes(first, last, cmp) < 0.125) {
+        return course::minmax_element(first, last, cmp);
+    }
+    return minmax_element_branchless(first, last, cmp);
+}
+
+// min, second min, max and second max in one pass.
+// As in minmax_element, ties go to the first minimum and the last maximum:
+// the results are the first two and the last two positions of a stable
+// sort. Each pair is ordered with one comparison; its smaller element is
+// compared with the second min and its larger with the second max, and
+// only when one of them gets in are the two elements inserted one by
+// one, in their order, so that ties are kept. On average 3n/2 comparisons
+// plus the rare insertions.
+
+template <typename I, typename Compare>
+// requires I is a ForwardIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+inline
+void insert_min_2(I& min1, I& min2, I candidate, Compare cmp) {
+    if (cmp(*candidate, *min2)) {
+        if (cmp(*candidate, *min1)) {
+            min2 = min1;
+            min1 = candidate;
+        } else {
+            min2 = candidate;
+        }
+    }
+}
+
+template <typename I, typename Compare>
+// requires I is a ForwardIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+inline
+void insert_max_2(I& max1, I& max2, I candidate, Compare cmp) {
+    if (!cmp(*candidate, *max2)) {
+        if (!cmp(*candidate, *max1)) {
+            max2 = max1;
+            max1 = candidate;
+        } else {
+            max2 = candidate;
+        }
+    }
+}
+
+template <typename I, typename Compare>
+// requires I is a ForwardIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+// returns: ((min, second min), (max, second max)); a missing element is last
+std::pair<std::pair<I, I>, std::pair<I, I> > minmax_2_element(I first, I last, Compare cmp) {
+    if (first == last) return std::make_pair(std::make_pair(last, last), std::make_pair(last, last));
+    I min1 = first;
+    ++first;
+    if (first == last) return std::make_pair(std::make_pair(min1, last), std::make_pair(min1, last));
+    I min2 = first;
+    ++first;
+    if (cmp(*min2, *min1)) {
+        std::swap(min1, min2);
+    }
+    I max1 = min2;
+    I max2 = min1;
+    while (first != last && successor(first) != last) {
+        I next = successor(first);
+        I potential_min = first;
+        I potential_max = next;
+        if (cmp(*potential_max, *potential_min)) {
+            std::swap(potential_max, potential_min);
+        }
+        if (cmp(*potential_min, *min2)) {
+            insert_min_2(min1, min2, first, cmp);
+            insert_min_2(min1, min2, next, cmp);
+        }
+        if (!cmp(*potential_max, *max2)) {
+            insert_max_2(max1, max2, first, cmp);
+            insert_max_2(max1, max2, next, cmp);
+        }
+        ++first;
+        ++first;
+    }
+    if (first != last) {
+        insert_min_2(min1, min2, first, cmp);
+        insert_max_2(max1, max2, first, cmp);
+    }
+    return std::make_pair(std::make_pair(min1, min2), std::make_pair(max1, max2));
+}
+
+// minmax_2_element(first, last, std::less<T>()) for arrays of arithmetic T.
+// Each lane keeps its two smallest and two largest values with their
+// indices; a lane sees its elements in index order, so strict comparisons
+// keep the earlier of equal minima and non-strict ones the later of equal
+// maxima. The lanes are merged on (value, index) at the end. Values must
+// not be NaN.
+
+template <typename T>
+// requires T is arithmetic
+std::pair<std::pair<const T*, const T*>, std::pair<const T*, const T*> >
+minmax_2_element_vector(const T* first, const T* last) {
+    return minmax_2_element(first, last, std::less<T>());
+}
+
+#if defined(__AVX2__)
+
+struct simd_int32
+{
+    typedef int32_t value_type;
+    typedef int32_t index_type;
+    typedef __m256i vector;
+    static const int lanes = 8;
+    static vector load(const value_type* p) { return _mm256_loadu_si256((const __m256i*)p); }
+    static void store(value_type* p, vector x) { _mm256_storeu_si256((__m256i*)p, x); }
+    static __m256i less(vector x, vector y) { return _mm256_cmpgt_epi32(y, x); }
+    static vector select(vector x, vector y, __m256i mask) { return _mm256_blendv_epi8(x, y, mask); }
+    static vector min(vector x, vector y) { return _mm256_min_epi32(x, y); }
+    static vector max(vector x, vector y) { return _mm256_max_epi32(x, y); }
+    static __m256i iota() { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+    static __m256i add_index(__m256i x, __m256i y) { return _mm256_add_epi32(x, y); }
+    static __m256i broadcast_index(index_type i) { return _mm256_set1_epi32(i); }
+};
+
+struct simd_float
+{
+    typedef float value_type;
+    typedef int32_t index_type;
+    typedef __m256 vector;
+    static const int lanes = 8;
+    static vector load(const value_type* p) { return _mm256_loadu_ps(p); }
+    static void store(value_type* p, vector x) { _mm256_storeu_ps(p, x); }
+    static __m256i less(vector x, vector y) { return _mm256_castps_si256(_mm256_cmp_ps(x, y, _CMP_LT_OQ)); }
+    static vector select(vector x, vector y, __m256i mask) {
+        return _mm256_blendv_ps(x, y, _mm256_castsi256_ps(mask));
+    }
+    static vector min(vector x, vector y) { return _mm256_min_ps(x, y); }
+    static vector max(vector x, vector y) { return _mm256_max_ps(x, y); }
+    static __m256i iota() { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+    static __m256i add_index(__m256i x, __m256i y) { return _mm256_add_epi32(x, y); }
+    static __m256i broadcast_index(index_type i) { return _mm256_set1_epi32(i); }
+};
+
+struct simd_double
+{
+    typedef double value_type;
+    typedef int64_t index_type;
+    typedef __m256d vector;
+    static const int lanes = 4;
+    static vector load(const value_type* p) { return _mm256_loadu_pd(p); }
+    static void store(value_type* p, vector x) { _mm256_storeu_pd(p, x); }
+    static __m256i less(vector x, vector y) { return _mm256_castpd_si256(_mm256_cmp_pd(x, y, _CMP_LT_OQ)); }
+    static vector select(vector x, vector y, __m256i mask) {
+        return _mm256_blendv_pd(x, y, _mm256_castsi256_pd(mask));
+    }
+    static vector min(vector x, vector y) { return _mm256_min_pd(x, y); }
+    static vector max(vector x, vector y) { return _mm256_max_pd(x, y); }
+    static __m256i iota() { return _mm256_setr_epi64x(0, 1, 2, 3); }
+    static __m256i add_index(__m256i x, __m256i y) { return _mm256_add_epi64(x, y); }
+    static __m256i broadcast_index(index_type i) { return _mm256_set1_epi64x(i); }
+};
+
+// 64 bit integers: AVX2 has a signed compare and no min or max; unsigned
+// values are compared with their top bit flipped
+template <typename T, bool is_signed>
+struct simd_int64
+{
+    typedef T value_type;
+    typedef int64_t index_type;
+    typedef __m256i vector;
+    static const int lanes = 4;
+    static vector load(const value_type* p) { return _mm256_loadu_si256((const __m256i*)p); }
+    static void store(value_type* p, vector x) { _mm256_storeu_si256((__m256i*)p, x); }
+    static __m256i less(vector x, vector y) {
+        if (is_signed) return _mm256_cmpgt_epi64(y, x);
+        const __m256i top = _mm256_set1_epi64x(int64_t(uint64_t(1) << 63));
+        return _mm256_cmpgt_epi64(_mm256_xor_si256(y, top), _mm256_xor_si256(x, top));
+    }
+    static vector select(vector x, vector y, __m256i mask) { return _mm256_blendv_epi8(x, y, mask); }
+    static vector min(vector x, vector y) { return select(x, y, less(y, x)); }
+    static vector max(vector x, vector y) { return select(y, x, less(y, x)); }
+    static __m256i iota() { return _mm256_setr_epi64x(0, 1, 2, 3); }
+    static __m256i add_index(__m256i x, __m256i y) { return _mm256_add_epi64(x, y); }
+    static __m256i broadcast_index(index_type i) { return _mm256_set1_epi64x(i); }
+};
+
+template <typename S>
+// requires S is one of the simd_ descriptions above
+struct minmax_2_lanes
+{
+    typedef typename S::value_type T;
+    typedef typename S::index_type N;
+    typedef typename S::vector V;
+
+    V min1, min2, max1, max2;
+    __m256i index_min1, index_min2, index_max1, index_max2;
+
+    // starts each lane with two consecutive blocks
+    void start(const T* p, __m256i index) {
+        __m256i next = S::add_index(index, S::broadcast_index(S::lanes));
+        V x0 = S::load(p);
+        V x1 = S::load(p + S::lanes);
+        __m256i swap = S::less(x1, x0);
+        min1 = S::select(x0, x1, swap);
+        min2 = S::select(x1, x0, swap);
+        max1 = min2;
+        max2 = min1;
+        index_min1 = _mm256_blendv_epi8(index, next, swap);
+        index_min2 = _mm256_blendv_epi8(next, index, swap);
+        // equal values: the later one is the max
+        index_max1 = index_min2;
+        index_max2 = index_min1;
+    }
+
+    void insert(const T* p, __m256i index) {
+        V x = S::load(p);
+        __m256i below_min2 = S::less(x, min2);
+        __m256i below_min1 = S::less(x, min1);
+        __m256i below_max2 = S::less(x, max2);
+        __m256i below_max1 = S::less(x, max1);
+        index_min2 = _mm256_blendv_epi8(_mm256_blendv_epi8(index_min2, index, below_min2),
+                                        index_min1, below_min1);
+        index_min1 = _mm256_blendv_epi8(index_min1, index, below_min1);
+        index_max2 = _mm256_blendv_epi8(index_max1, _mm256_blendv_epi8(index, index_max2, below_max2),
+                                        below_max1);
+        index_max1 = _mm256_blendv_epi8(index, index_max1, below_max1);
+        min2 = S::min(min2, S::max(min1, x));
+        min1 = S::min(min1, x);
+        max2 = S::max(max2, S::min(max1, x));
+        max1 = S::max(max1, x);
+    }
+
+    // appends the lanes' (value, index) pairs: min1, min2, max1, max2
+    void store(std::pair<T, N>* out) const {
+        T values[4][S::lanes];
+        N indices[4][S::lanes];
+        S::store(values[0], min1);
+        S::store(values[1], min2);
+        S::store(values[2], max1);
+        S::store(values[3], max2);
+        _mm256_storeu_si256((__m256i*)indices[0], index_min1);
+        _mm256_storeu_si256((__m256i*)indices[1], index_min2);
+        _mm256_storeu_si256((__m256i*)indices[2], index_max1);
+        _mm256_storeu_si256((__m256i*)indices[3], index_max2);
+        for (int k = 0; k < 4; ++k) {
+            for (int i = 0; i < S::lanes; ++i) out[k * S::lanes + i] = std::make_pair(values[k][i], indices[k][i]);
+        }
+    }
+};
+
+template <typename S>
+// requires S is one of the simd_ descriptions above
+std::pair<std::pair<const typename S::value_type*, const typename S::value_type*>,
+          std::pair<const typename S::value_type*, const typename S::value_type*> >
+minmax_2_element_avx2(const typename S::value_type* first, const typename S::value_type* last) {
+    typedef typename S::value_type T;
+    typedef typename S::index_type N;
+    typedef std::pair<T, N> indexed;
+    const int lanes = S::lanes;
+    std::ptrdiff_t n = last - first;
+    if (n < 4 * lanes || uint64_t(n) > uint64_t(std::numeric_limits<N>::max())) {
+        return minmax_2_element(first, last, std::less<T>());
+    }
+
+    // two independent sets of lanes, taking alternate blocks
+    minmax_2_lanes<S> a, b;
+    __m256i index = S::iota();
+    const __m256i step = S::broadcast_index(lanes);
+    const __m256i double_step = S::add_index(step, step);
+    a.start(first, index);
+    index = S::add_index(index, double_step);
+    b.start(first + 2 * lanes, index);
+    index = S::add_index(index, double_step);
+    const T* p = first + 4 * lanes;
+    for (; last - p >= 2 * lanes; p += 2 * lanes) {
+        a.insert(p, index);
+        index = S::add_index(index, step);
+        b.insert(p + lanes, index);
+        index = S::add_index(index, step);
+    }
+    if (last - p >= lanes) {
+        a.insert(p, index);
+        p += lanes;
+    }
+
+    // merge the lanes on (value, index); indices are distinct, so the
+    // lexicographic order settles every tie
+    indexed candidates[8 * lanes];
+    a.store(candidates);
+    b.store(candidates + 4 * lanes);
+    std::less<indexed> cmp;
+    const indexed* min1 = candidates;
+    const indexed* min2 = candidates + lanes;
+    const indexed* max1 = candidates + 2 * lanes;
+    const indexed* max2 = candidates + 3 * lanes;
+    for (int k = 0; k < 2; ++k) {
+        const indexed* lane = candidates + 4 * k * lanes;
+        for (int i = k == 0 ? 1 : 0; i < lanes; ++i) {
+            insert_min_2(min1, min2, lane + i, cmp);
+            insert_min_2(min1, min2, lane + lanes + i, cmp);
+            insert_max_2(max1, max2, lane + 2 * lanes + i, cmp);
+            insert_max_2(max1, max2, lane + 3 * lanes + i, cmp);
+        }
+    }
+
+    // the tail comes after every lane
+    const T* result_min1 = first + min1->second;
+    const T* result_min2 = first + min2->second;
+    const T* result_max1 = first + max1->second;
+    const T* result_max2 = first + max2->second;
+    std::less<T> less;
+    for (; p != last; ++p) {
+        insert_min_2(result_min1, result_min2, p, less);
+        insert_max_2(result_max1, result_max2, p, less);
+    }
+    return std::make_pair(std::make_pair(result_min1, result_min2),
+                          std::make_pair(result_max1, result_max2));
+}
+
+inline
+std::pair<std::pair<const int32_t*, const int32_t*>, std::pair<const int32_t*, const int32_t*> >
+minmax_2_element_vector(const int32_t* first, const int32_t* last) {
+    return minmax_2_element_avx2<simd_int32>(first, last);
+}
+
+inline
+std::pair<std::pair<const float*, const float*>, std::pair<const float*, const float*> >
+minmax_2_element_vector(const float* first, const float* last) {
+    return minmax_2_element_avx2<simd_float>(first, last);
+}
+
+inline
+std::pair<std::pair<const double*, const double*>, std::pair<const double*, const double*> >
+minmax_2_element_vector(const double* first, const double* last) {
+    return minmax_2_element_avx2<simd_double>(first, last);
+}
+
+inline
+std::pair<std::pair<const int64_t*, const int64_t*>, std::pair<const int64_t*, const int64_t*> >
+minmax_2_element_vector(const int64_t* first, const int64_t* last) {
+    return minmax_2_element_avx2<simd_int64<int64_t, true> >(first, last);
+}
+
+inline
+std::pair<std::pair<const uint64_t*, const uint64_t*>, std::pair<const uint64_t*, const uint64_t*> >
+minmax_2_element_vector(const uint64_t* first, const uint64_t* last) {
+    return minmax_2_element_avx2<simd_int64<uint64_t, false> >(first, last);
+}
+
+#endif
+
+template <typename T>
+// requires T is arithmetic
+// returns: the same as minmax_2_element(first, last, std::less<T>())
+std::pair<std::pair<T*, T*>, std::pair<T*, T*> > minmax_2_element_simd(T* first, T* last) {
+    std::pair<std::pair<const T*, const T*>, std::pair<const T*, const T*> > result =
+        minmax_2_element_vector((const T*)first, (const T*)last);
+    return std::make_pair(std::make_pair(first + (result.first.first - first),
+                                         first + (result.first.second - first)),
+                          std::make_pair(first + (result.second.first - first),
+                                         first + (result.second.second - first)));
+}
+
+
+// minmax_element for arrays of arithmetic T with std::less: the same
+// first minimum and last maximum, found by lanes that track the minimum
+// and maximum with their indices and are merged on (value, index).
+// The pairing of the scalar version saves comparisons, but on arrays of
+// numbers it is the branches that cost; the lanes have none. Values must
+// not be NaN.
+
+// whether minmax_element_vector has lanes for T on this target
+template <typename T>
+struct minmax_vectorized
+{
+    static const bool value = false;
+};
+
+template <typename T>
+// requires T is arithmetic
+std::pair<const T*, const T*> minmax_element_vector(const T* first, const T* last) {
+    // the explicit arguments select the generic version, not the overload
+    // for pointers below
+    return course::minmax_element<const T*, std::less<T> >(first, last, std::less<T>());
+}
+
+#if defined(__AVX2__)
+
+template <typename S>
+// requires S is one of the simd_ descriptions above
+struct minmax_lanes
+{
+    typedef typename S::value_type T;
+    typedef typename S::index_type N;
+    typedef typename S::vector V;
+
+    V min, max;
+    __m256i index_min, index_max;
+
+    void start(const T* p, __m256i index) {
+        min = max = S::load(p);
+        index_min = index_max = index;
+    }
+
+    void insert(const T* p, __m256i index) {
+        V x = S::load(p);
+        index_min = _mm256_blendv_epi8(index_min, index, S::less(x, min));
+        index_max = _mm256_blendv_epi8(index, index_max, S::less(x, max));
+        min = S::min(min, x);
+        max = S::max(max, x);
+    }
+
+    template <typename Compare>
+    void merge_into(const std::pair<T, N>*& min_place, const std::pair<T, N>*& max_place,
+                    std::pair<T, N>* candidates, Compare cmp) const {
+        T mins[S::lanes], maxs[S::lanes];
+        N min_indices[S::lanes], max_indices[S::lanes];
+        S::store(mins, min);
+        S::store(maxs, max);
+        _mm256_storeu_si256((__m256i*)min_indices, index_min);
+        _mm256_storeu_si256((__m256i*)max_indices, index_max);
+        for (int i = 0; i < S::lanes; ++i) {
+            candidates[2 * i] = std::make_pair(mins[i], min_indices[i]);
+            candidates[2 * i + 1] = std::make_pair(maxs[i], max_indices[i]);
+            if (!min_place || cmp(candidates[2 * i], *min_place)) min_place = candidates + 2 * i;
+            if (!max_place || !cmp(candidates[2 * i + 1], *max_place)) max_place = candidates + 2 * i + 1;
+        }
+    }
+};
+
+template <typename S>
+// requires S is one of the simd_ descriptions above
+std::pair<const typename S::value_type*, const typename S::value_type*>
+minmax_element_avx2(const typename S::value_type* first, const typename S::value_type* last) {
+    typedef typename S::value_type T;
+    typedef typename S::index_type N;
+    typedef std::pair<T, N> indexed;
+    const int lanes = S::lanes;
+    std::ptrdiff_t n = last - first;
+    if (n < 2 * lanes || uint64_t(n) > uint64_t(std::numeric_limits<N>::max())) {
+        return course::minmax_element<const T*, std::less<T> >(first, last, std::less<T>());
+    }
+
+    // two independent sets of lanes, taking alternate blocks
+    minmax_lanes<S> a, b;
+    __m256i index = S::iota();
+    const __m256i step = S::broadcast_index(lanes);
+    a.start(first, index);
+    index = S::add_index(index, step);
+    b.start(first + lanes, index);
+    index = S::add_index(index, step);
+    const T* p = first + 2 * lanes;
+    for (; last - p >= 2 * lanes; p += 2 * lanes) {
+        a.insert(p, index);
+        index = S::add_index(index, step);
+        b.insert(p + lanes, index);
+        index = S::add_index(index, step);
+    }
+    if (last - p >= lanes) {
+        a.insert(p, index);
+        p += lanes;
+    }
+
+    indexed candidates[4 * lanes];
+    const indexed* min_place = 0;
+    const indexed* max_place = 0;
+    a.merge_into(min_place, max_place, candidates, std::less<indexed>());
+    b.merge_into(min_place, max_place, candidates + 2 * lanes, std::less<indexed>());
+
+    // the tail comes after every lane
+    const T* min_el = first + min_place->second;
+    const T* max_el = first + max_place->second;
+    for (; p != last; ++p) {
+        if (*p < *min_el) min_el = p;
+        if (!(*p < *max_el)) max_el = p;
+    }
+    return std::make_pair(min_el, max_el);
+}
+
+template <> struct minmax_vectorized<int32_t> { static const bool value = true; };
+template <> struct minmax_vectorized<float> { static const bool value = true; };
+template <> struct minmax_vectorized<double> { static const bool value = true; };
+template <> struct minmax_vectorized<int64_t> { static const bool value = true; };
+template <> struct minmax_vectorized<uint64_t> { static const bool value = true; };
+
+inline
+std::pair<const int32_t*, const int32_t*> minmax_element_vector(const int32_t* first, const int32_t* last) {
+    return minmax_element_avx2<simd_int32>(first, last);
+}
+
+inline
+std::pair<const float*, const float*> minmax_element_vector(const float* first, const float* last) {
+    return minmax_element_avx2<simd_float>(first, last);
+}
+
+inline
+std::pair<const double*, const double*> minmax_element_vector(const double* first, const double* last) {
+    return minmax_element_avx2<simd_double>(first, last);
+}
+
+inline
+std::pair<const int64_t*, const int64_t*> minmax_element_vector(const int64_t* first, const int64_t* last) {
+    return minmax_element_avx2<simd_int64<int64_t, true> >(first, last);
+}
+
+inline
+std::pair<const uint64_t*, const uint64_t*> minmax_element_vector(const uint64_t* first, const uint64_t* last) {
+    return minmax_element_avx2<simd_int64<uint64_t, false> >(first, last);
+}
+
+#endif
+
+template <typename T>
+// minmax_element(first, last, std::less<T>()) on an array of arithmetic T
+// goes to the lanes; any other T to the generic version
+std::pair<T*, T*> minmax_element(T* first, T* last, std::less<T>) {
+    std::pair<const T*, const T*> result = minmax_element_vector((const T*)first, (const T*)last);
+    return std::make_pair(first + (result.first - first), first + (result.second - first));
+}
+
+template <typename T>
+// minmax_element_auto on an array of T with std::less: the lanes, which
+// have no branches to mispredict, wherever there are lanes for T
+std::pair<T*, T*> minmax_element_auto(T* first, T* last, std::less<T> cmp) {
+    if (minmax_vectorized<T>::value) return course::minmax_element(first, last, cmp);
+    return course::minmax_element_auto<T*, std::less<T> >(first, last, cmp);
+}
+
 } // end namespace course
@@ -0,0 +1,119 @@
+/*--------------------------------------------------------------------------------------
+ * minmax_2.cpp
+ *
+ * min, second min, max and second max: three passes against the fused
+ * pass of minmax_2_element, scalar and (built with -mavx2) vectorized
+ *--------------------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <cstdlib>
+#include <ctime>
+
+#include <functional>
+#include <algorithm>
+#include <vector>
+
+#include <iostream>
+#include <iomanip>
+
+#include "algorithm.h"
+#include "concepts.h"
+#include "minmax.h"
+
+namespace course {
+
+// minmax_element, then one pass for each runner-up
+template <typename I, typename Compare>
+std::pair<std::pair<I, I>, std::pair<I, I> > minmax_2_element_three_pass(I first, I last, Compare cmp) {
+  std::pair<I, I> m = course::minmax_element(first, last, cmp);
+  I min2 = last;
+  I max2 = last;
+  for (I i = first; i != last; ++i) {
+    if (i != m.first && (min2 == last || cmp(*i, *min2))) min2 = i;
+  }
+  for (I i = first; i != last; ++i) {
+    if (i != m.second && (max2 == last || !cmp(*i, *max2))) max2 = i;
+  }
+  return std::make_pair(std::make_pair(m.first, min2), std::make_pair(m.second, max2));
+}
+
+double comparisons = 0;
+
+struct counting_compare
+{
+  template <typename T>
+  bool operator()(const T& x, const T& y) const {
+    ++comparisons;
+    return x < y;
+  }
+};
+
+template <typename T>
+std::pair<std::pair<T*, T*>, std::pair<T*, T*> > fused_scalar(T* first, T* last) {
+  return minmax_2_element(first, last, std::less<T>());
+}
+
+template <typename T>
+std::pair<std::pair<T*, T*>, std::pair<T*, T*> > three_pass(T* first, T* last) {
+  return minmax_2_element_three_pass(first, last, std::less<T>());
+}
+
+template <typename T>
+double time_per_element(std::pair<std::pair<T*, T*>, std::pair<T*, T*> > (*algorithm)(T*, T*),
+                        std::vector<T>& seq, size_t iterations,
+                        const std::pair<std::pair<T*, T*>, std::pair<T*, T*> >& expected) {
+  T* first = &*seq.begin();
+  T* last = first + seq.size();
+  std::pair<std::pair<T*, T*>, std::pair<T*, T*> > result;
+  double time = clock();
+  for (size_t i = 0; i < iterations; ++i) result = algorithm(first, last);
+  time = clock() - time;
+  if (result != expected) std::cout << "Failed: different results\n";
+  return time * (1000000000.0 / double(CLOCKS_PER_SEC)) / double(iterations * seq.size());
+}
+
+template <typename T>
+void print_times(size_t n) {
+  std::cout << "\nns per element\n" << "\tn\t three_pass\t  fused\t   fused_simd\n";
+  for (size_t i(64); i < n; i <<= 2) {
+    std::vector<T> seq(i);
+    course::iota(seq.begin(), seq.end(), T(0));
+    std::random_shuffle(seq.begin(), seq.end());
+    std::pair<std::pair<T*, T*>, std::pair<T*, T*> > expected =
+      minmax_2_element_three_pass(&*seq.begin(), &*seq.begin() + i, std::less<T>());
+    size_t iterations = std::max(size_t(1), n / i);
+    std::cout << std::setw(9) << i << std::fixed << std::setprecision(2)
+              << "\t\t" << time_per_element(three_pass<T>, seq, iterations, expected)
+              << "\t\t" << time_per_element(fused_scalar<T>, seq, iterations, expected)
+              << "\t\t" << time_per_element(minmax_2_element_simd<T>, seq, iterations, expected)
+              << std::endl;
+  }
+}
+
+void print_comparisons(size_t n) {
+  std::cout << "Comparisons per element\n" << "\tn\t three_pass\t  fused\n";
+  counting_compare cmp;
+  for (size_t i(64); i < n; i <<= 2) {
+    std::vector<uint64_t> seq(i);
+    course::iota(seq.begin(), seq.end(), uint64_t(0));
+    std::random_shuffle(seq.begin(), seq.end());
+    comparisons = 0;
+    minmax_2_element_three_pass(seq.begin(), seq.end(), cmp);
+    double three = comparisons;
+    comparisons = 0;
+    minmax_2_element(seq.begin(), seq.end(), cmp);
+    std::cout << std::setw(9) << i << std::fixed << std::setprecision(2)
+              << "\t\t" << three / i << "\t\t" << comparisons / i << std::endl;
+  }
+}
+
+} // end of namespace course
+
+int main() {
+  std::srand(unsigned(std::time(0)));
+  course::print_comparisons(16 * 1024 * 1024);
+  std::cout << "\nuint64_t";
+  course::print_times<uint64_t>(64 * 1024 * 1024);
+  std::cout << "\ndouble";
+  course::print_times<double>(64 * 1024 * 1024);
+}
@@ -0,0 +1,127 @@
+#ifndef MINMAX_ACCUMULATOR_H
+#define MINMAX_ACCUMULATOR_H
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+
+#include "minmax.h"
+
+namespace course {
+
+// minmax_element for data that is never in memory all at once: chunks
+// arrive in order and only the values of the minimum and maximum are
+// kept, with their positions in the whole sequence. Accumulators of
+// consecutive parts of a sequence merge associatively (the first minimum
+// and the last maximum win, as in minmax_element), so the parts can be
+// done by different threads.
+
+template <typename T, typename Compare = std::less<T> >
+// requires Compare is a StrictWeakOrdering on T
+class minmax_accumulator
+{
+private:
+    Compare cmp;
+    T min_value;
+    T max_value;
+    uint64_t min_pos;
+    uint64_t max_pos;
+    uint64_t n;
+
+public:
+    minmax_accumulator() : cmp(), min_pos(0), max_pos(0), n(0) {}
+    minmax_accumulator(const Compare& cmp) : cmp(cmp), min_pos(0), max_pos(0), n(0) {}
+
+    bool empty() const { return n == 0; }
+
+    // the number of elements consumed
+    uint64_t size() const { return n; }
+
+    // precondition: !empty()
+    const T& min() const { return min_value; }
+    const T& max() const { return max_value; }
+    uint64_t min_position() const { return min_pos; }
+    uint64_t max_position() const { return max_pos; }
+
+    template <typename I>
+    // requires I is a ForwardIterator and ValueType(I) == T
+    void add(I first, I last) {
+        if (first == last) return;
+        std::pair<I, I> m = course::minmax_element(first, last, cmp);
+        uint64_t chunk_size = std::distance(first, last);
+        minmax_accumulator chunk(cmp);
+        chunk.min_value = *m.first;
+        chunk.max_value = *m.second;
+        chunk.min_pos = std::distance(first, m.first);
+        chunk.max_pos = std::distance(first, m.second);
+        chunk.n = chunk_size;
+        merge(chunk);
+    }
+
+    void add(const T& x) {
+        add(&x, &x + 1);
+    }
+
+    // appends the elements seen by y, which come after those seen by *this
+    void merge(const minmax_accumulator& y) {
+        if (y.empty()) return;
+        if (empty() || cmp(y.min_value, min_value)) {
+            min_value = y.min_value;
+            min_pos = n + y.min_pos;
+        }
+        if (empty() || !cmp(y.max_value, max_value)) {
+            max_value = y.max_value;
+            max_pos = n + y.max_pos;
+        }
+        n += y.n;
+    }
+};
+
+template <typename I, typename Compare>
+// requires I is a RandomAccessIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+struct minmax_accumulate_worker
+{
+    I first;
+    I last;
+    minmax_accumulator<typename std::iterator_traits<I>::value_type, Compare>* result;
+
+    minmax_accumulate_worker(I first, I last,
+                             minmax_accumulator<typename std::iterator_traits<I>::value_type, Compare>& result) :
+        first(first), last(last), result(&result) {}
+
+    void operator()() {
+        result->add(first, last);
+    }
+};
+
+template <typename I, typename Compare>
+// requires I is a RandomAccessIterator
+// and Compare is a StrictWeakOrdering on ValueType(I)
+// returns: the accumulator of [first, last), built by threads on
+// consecutive parts and merged in order
+minmax_accumulator<typename std::iterator_traits<I>::value_type, Compare>
+minmax_parallel(I first, I last, Compare cmp, unsigned threads) {
+    typedef minmax_accumulator<typename std::iterator_traits<I>::value_type, Compare> accumulator;
+    if (threads == 0) threads = 1;
+    typename std::iterator_traits<I>::difference_type n = last - first;
+    std::vector<accumulator> parts(threads, accumulator(cmp));
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; ++t) {
+        workers.push_back(std::thread(
+            minmax_accumulate_worker<I, Compare>(first + n * t / threads, first + n * (t + 1) / threads,
+                                                 parts[t])));
+    }
+    minmax_accumulate_worker<I, Compare>(first, first + n / threads, parts[0])();
+    for (std::size_t t = 0; t < workers.size(); ++t) workers[t].join();
+    for (unsigned t = 1; t < threads; ++t) parts[0].merge(parts[t]);
+    return parts[0];
+}
+
+} // end namespace course
+
+#endif
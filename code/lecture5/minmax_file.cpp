@@ -0,0 +1,155 @@
+/*--------------------------------------------------------------------------------------
+ * minmax_file.cpp
+ *
+ * minmax of a file of uint64_t read in chunks, by one thread and by
+ * several threads each reading its own part, against the time to just
+ * read the file.
+ *
+ * usage: minmax_file [path [megabytes [threads]]]
+ * path defaults to /tmp/minmax.dat, kept for the next run;
+ * the file is (re)written with random values if it is shorter than asked;
+ * drop the page cache between runs to measure the disk rather than memory
+ *--------------------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <cstdio>
+#include <cstdlib>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <iostream>
+#include <iomanip>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "minmax_accumulator.h"
+
+typedef course::minmax_accumulator<uint64_t> accumulator;
+
+const size_t chunk_bytes = 4 << 20;
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void write_file(const char* path, uint64_t bytes) {
+  FILE* f = std::fopen(path, "wb");
+  if (!f) {
+    std::cerr << "cannot create " << path << std::endl;
+    std::exit(1);
+  }
+  std::vector<uint64_t> chunk(chunk_bytes / sizeof(uint64_t));
+  uint64_t x = 88172645463325252ull;
+  for (uint64_t written = 0; written < bytes; written += chunk_bytes) {
+    for (size_t i = 0; i < chunk.size(); ++i) {
+      // xorshift
+      x ^= x << 13;
+      x ^= x >> 7;
+      x ^= x << 17;
+      chunk[i] = x;
+    }
+    std::fwrite(&chunk[0], 1, std::min<uint64_t>(chunk_bytes, bytes - written), f);
+  }
+  std::fclose(f);
+}
+
+// reads bytes at position into buffer, going on after short reads
+// returns: the number of bytes read, less than asked only at the end of
+// the file or on an error
+size_t pread_fully(int fd, void* buffer, size_t bytes, uint64_t position) {
+  size_t done = 0;
+  while (done < bytes) {
+    ssize_t got = pread(fd, static_cast<char*>(buffer) + done, bytes - done, position + done);
+    if (got <= 0) break;
+    done += got;
+  }
+  return done;
+}
+
+// reads [offset, offset + bytes) of the file in chunks into acc, or just reads it
+struct read_part
+{
+  int fd;
+  uint64_t offset;
+  uint64_t bytes;
+  accumulator* acc;
+
+  void operator()() {
+    std::vector<uint64_t> chunk(chunk_bytes / sizeof(uint64_t));
+    uint64_t end = offset + bytes;
+    for (uint64_t position = offset; position < end; ) {
+      // whole chunks keep every value of the part aligned in the buffer
+      size_t wanted = std::min<uint64_t>(chunk_bytes, end - position);
+      size_t got = pread_fully(fd, &chunk[0], wanted, position);
+      if (acc) acc->add(&chunk[0], &chunk[0] + got / sizeof(uint64_t));
+      position += got;
+      if (got < wanted) break;
+    }
+  }
+};
+
+accumulator minmax_file(int fd, uint64_t bytes, unsigned threads, bool accumulate) {
+  // parts are whole numbers of values
+  uint64_t n = bytes / sizeof(uint64_t);
+  if (threads == 0) threads = 1;
+  std::vector<accumulator> parts(threads);
+  std::vector<read_part> readers(threads);
+  for (unsigned t = 0; t < threads; ++t) {
+    uint64_t first = n * t / threads;
+    uint64_t last = n * (t + 1) / threads;
+    read_part r = {fd, first * sizeof(uint64_t), (last - first) * sizeof(uint64_t),
+                   accumulate ? &parts[t] : 0};
+    readers[t] = r;
+  }
+  std::vector<std::thread> workers;
+  for (unsigned t = 1; t < threads; ++t) workers.push_back(std::thread(readers[t]));
+  readers[0]();
+  for (size_t t = 0; t < workers.size(); ++t) workers[t].join();
+  for (unsigned t = 1; t < threads; ++t) parts[0].merge(parts[t]);
+  return parts[0];
+}
+
+int main(int argc, char** argv) {
+  const char* path = argc > 1 ? argv[1] : "/tmp/minmax.dat";
+  uint64_t megabytes = argc > 2 ? std::strtoull(argv[2], 0, 10) : 2048;
+  unsigned threads = argc > 3 ? unsigned(std::max(1, std::atoi(argv[3])))
+                              : std::max(1u, std::thread::hardware_concurrency());
+  uint64_t bytes = megabytes << 20;
+
+  struct stat st;
+  if (stat(path, &st) != 0 || uint64_t(st.st_size) < bytes) write_file(path, bytes);
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    std::cerr << "cannot open " << path << std::endl;
+    return 1;
+  }
+
+  std::cout << megabytes << " MB, MB/s" << std::endl;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  minmax_file(fd, bytes, 1, false);
+  std::cout << std::setw(24) << "read only" << std::setw(10) << std::fixed << std::setprecision(0)
+            << megabytes / seconds_since(start) << std::endl;
+
+  start = std::chrono::steady_clock::now();
+  accumulator serial = minmax_file(fd, bytes, 1, true);
+  std::cout << std::setw(24) << "read and minmax" << std::setw(10)
+            << megabytes / seconds_since(start) << std::endl;
+
+  start = std::chrono::steady_clock::now();
+  accumulator parallel = minmax_file(fd, bytes, threads, true);
+  std::cout << std::setw(18) << threads << " threads" << std::setw(10)
+            << megabytes / seconds_since(start) << std::endl;
+
+  std::cout << "min " << serial.min() << " at " << serial.min_position()
+            << ", max " << serial.max() << " at " << serial.max_position() << std::endl;
+  if (serial.min_position() != parallel.min_position() || serial.max_position() != parallel.max_position()) {
+    std::cout << "Failed: different mins or maxs" << std::endl;
+  }
+  close(fd);
+}